@@ -0,0 +1,112 @@
+/*
+ * Example of a deadline-ordered queue
+ * Requests are received earliest deadline first, not in order of arrival.
+ * Needs configUSE_DEADLINE_ORDERED_QUEUES set to 1 in FreeRTOSConfig.h.
+ */
+
+// Include Arduino FreeRTOS library
+#include <Arduino_FreeRTOS.h>
+
+// Include queue support
+#include <queue.h>
+
+/*
+ * Every item must start with its deadline, as a TickType_t.
+ */
+struct request {
+  TickType_t deadline;
+  int pin;
+};
+
+/*
+ * Declaring a global variable of type QueueHandle_t
+ *
+ */
+QueueHandle_t requestQueue;
+
+void setup() {
+
+  /**
+   * Create a queue ordered by the leading deadline of each item.
+   */
+  requestQueue = xQueueCreateDeadlineOrdered(8, // Queue length
+                                             sizeof(struct request) // Queue item size
+                                             );
+
+  if (requestQueue != NULL) {
+
+    // Create task that serves the requests.
+    xTaskCreate(TaskSerial, // Task function
+                "Serial", // A name just for humans
+                128,  // This stack size can be checked & adjusted by reading the Stack Highwater
+                NULL,
+                1, // Priority, with 3 (configMAX_PRIORITIES - 1) being the highest, and 0 being the lowest.
+                NULL);
+
+    // Create task that posts requests with different deadlines.
+    xTaskCreate(TaskRequests, // Task function
+                "Requests", // Task name
+                128,  // Stack size
+                NULL,
+                2, // Priority
+                NULL);
+  }
+}
+
+void loop() {}
+
+
+/**
+ * Request task
+ * Posts a relaxed request for pin A0 and then an urgent one for pin A1.
+ * The urgent one is served first.
+ */
+void TaskRequests(void *pvParameters)
+{
+  (void) pvParameters;
+
+  for (;;)
+  {
+    struct request currentRequest;
+
+    currentRequest.deadline = xTaskGetTickCount() + pdMS_TO_TICKS(500);
+    currentRequest.pin = 0;
+    xQueueSend(requestQueue, &currentRequest, portMAX_DELAY);
+
+    currentRequest.deadline = xTaskGetTickCount() + pdMS_TO_TICKS(100);
+    currentRequest.pin = 1;
+    xQueueSend(requestQueue, &currentRequest, portMAX_DELAY);
+
+    vTaskDelay(pdMS_TO_TICKS(1000));
+  }
+}
+
+/**
+ * Serial task.
+ * Serves the request with the earliest deadline first.
+ */
+void TaskSerial(void * pvParameters) {
+  (void) pvParameters;
+
+  // Init Arduino serial
+  Serial.begin(9600);
+
+  // Wait for serial port to connect. Needed for native USB, on LEONARDO, MICRO, YUN, and other 32u4 based boards.
+  while (!Serial) {
+    vTaskDelay(1);
+  }
+
+  for (;;)
+  {
+    struct request currentRequest;
+
+    if (xQueueReceive(requestQueue, &currentRequest, portMAX_DELAY) == pdPASS) {
+      Serial.print("Pin: ");
+      Serial.print(currentRequest.pin);
+      Serial.print(" Value: ");
+      Serial.print(analogRead(currentRequest.pin == 0 ? A0 : A1));
+      Serial.print(" Deadline: ");
+      Serial.println((unsigned) currentRequest.deadline);
+    }
+  }
+}
@@ -0,0 +1,93 @@
+/*
+ * Example of a ring channel from an Arduino interrupt to a task
+ * The interrupt hands each event's timestamp to the task without masking
+ * interrupts. A channel has exactly one writer and one reader.
+ */
+
+// Include Arduino FreeRTOS library
+#include <Arduino_FreeRTOS.h>
+
+// Include ring channel support
+#include <ring_channel.h>
+
+/*
+ * The channel and its storage are static, so no heap is needed.
+ * A channel of length 8 holds up to 7 items.
+ */
+static uint8_t channelStorage[8 * sizeof(unsigned long)];
+static RingChannel_t channel;
+
+void setup() {
+
+  // Configure pin 2 as an input and enable the internal pull-up resistor
+  pinMode(2, INPUT_PULLUP);
+
+  xRingChannelCreateStatic(8, // Channel length
+                           sizeof(unsigned long), // Item size
+                           channelStorage,
+                           &channel);
+
+  // Create the one task that reads the channel.
+  xTaskCreate(TaskSerial, // Task function
+              "Serial", // A name just for humans
+              128,  // This stack size can be checked & adjusted by reading the Stack Highwater
+              NULL,
+              2, // Priority, with 3 (configMAX_PRIORITIES - 1) being the highest, and 0 being the lowest.
+              NULL);
+
+  // Attach interrupt for Arduino digital pin
+  attachInterrupt(digitalPinToInterrupt(2), interruptHandler, FALLING);
+}
+
+void loop() {}
+
+
+void interruptHandler() {
+  BaseType_t higherPriorityTaskWoken = pdFALSE;
+  unsigned long timestamp = micros();
+
+  /**
+   * Copy the timestamp into the channel.
+   * If the channel is full the event is dropped.
+   */
+  xRingChannelSendFromISR(&channel, &timestamp, &higherPriorityTaskWoken);
+
+  if (higherPriorityTaskWoken == pdTRUE) {
+    taskYIELD();
+  }
+}
+
+
+/**
+ * Serial task.
+ * Prints the time between presses.
+ */
+void TaskSerial(void * pvParameters) {
+  (void) pvParameters;
+
+  // Init Arduino serial
+  Serial.begin(9600);
+
+  // Wait for serial port to connect. Needed for native USB, on LEONARDO, MICRO, YUN, and other 32u4 based boards.
+  while (!Serial) {
+    vTaskDelay(1);
+  }
+
+  unsigned long lastTimestamp = 0;
+
+  for (;;)
+  {
+    unsigned long timestamp;
+
+    /**
+     * Block until the interrupt sends an item.
+     */
+    if (xRingChannelReceive(&channel, &timestamp, portMAX_DELAY) == pdPASS) {
+      Serial.print("Interval (us): ");
+      Serial.print(timestamp - lastTimestamp);
+      Serial.print(" Pending: ");
+      Serial.println((unsigned) uxRingChannelItemsWaiting(&channel));
+      lastTimestamp = timestamp;
+    }
+  }
+}
@@ -0,0 +1,167 @@
+/*
+ * Example of zero-copy stream buffers and a multi-producer message buffer
+ * https://www.freertos.org/RTOS-stream-message-buffers.html
+ * A stream buffer is written and parsed in place through spans, and two
+ * tasks log to one message buffer without a mutex.
+ * Needs configUSE_STREAM_BUFFER_ZERO_COPY and
+ * configUSE_STREAM_BUFFER_MULTI_PRODUCER set to 1 in FreeRTOSConfig.h.
+ */
+
+// Include Arduino FreeRTOS library
+#include <Arduino_FreeRTOS.h>
+
+// Include stream and message buffer support
+#include <stream_buffer.h>
+#include <message_buffer.h>
+
+/*
+ * Declaring the global buffer handles
+ * sampleStream carries raw bytes, logBuffer carries whole text messages.
+ */
+StreamBufferHandle_t sampleStream;
+MessageBufferHandle_t logBuffer;
+
+void setup() {
+
+  // A stream buffer of 32 bytes that wakes the reader once 8 bytes are in it.
+  sampleStream = xStreamBufferCreate(32, 8);
+
+  // A message buffer any task or interrupt can send to at the same time.
+  logBuffer = xMessageBufferCreateMultiProducer(64);
+
+  if (sampleStream != NULL && logBuffer != NULL) {
+
+    // Create task that drains both buffers.
+    xTaskCreate(TaskSerial, // Task function
+                "Serial", // A name just for humans
+                128,  // This stack size can be checked & adjusted by reading the Stack Highwater
+                NULL,
+                2, // Priority, with 3 (configMAX_PRIORITIES - 1) being the highest, and 0 being the lowest.
+                NULL);
+
+    // Create task that writes samples in place.
+    xTaskCreate(TaskAnalogRead, // Task function
+                "AnalogRead", // Task name
+                128,  // Stack size
+                NULL,
+                1, // Priority
+                NULL);
+
+    // Create task that logs alongside the sampler.
+    xTaskCreate(TaskBlink, // Task function
+                "Blink", // Task name
+                128, // Stack size
+                NULL,
+                0, // Priority
+                NULL );
+  }
+}
+
+void loop() {}
+
+
+/**
+ * Analog read task
+ * Writes the top eight bits of each reading straight into the stream buffer,
+ * and logs every time a block of samples is written.
+ */
+void TaskAnalogRead(void *pvParameters)
+{
+  (void) pvParameters;
+
+  for (;;)
+  {
+    StreamBufferSpans_t spans;
+
+    /**
+     * Get up to eight bytes of free space, in one or two runs.
+     */
+    size_t length = xStreamBufferAcquireWrite(sampleStream, 8, &spans, portMAX_DELAY);
+
+    for (size_t i = 0; i < spans.xLength[0]; i++) {
+      spans.pucData[0][i] = analogRead(A0) >> 2;
+    }
+    for (size_t i = 0; i < spans.xLength[1]; i++) {
+      spans.pucData[1][i] = analogRead(A0) >> 2;
+    }
+
+    // Make the bytes visible to the reader.
+    vStreamBufferCommitWrite(sampleStream, length);
+
+    // Sends to a multi-producer buffer never block; a message that does not fit is dropped.
+    xMessageBufferSend(logBuffer, "sampled", 7, 0);
+
+    vTaskDelay(10);
+  }
+}
+
+/**
+ * Serial task.
+ * Prints the samples where they lie in the buffer, then the log.
+ */
+void TaskSerial(void * pvParameters) {
+  (void) pvParameters;
+
+  // Init Arduino serial
+  Serial.begin(9600);
+
+  // Wait for serial port to connect. Needed for native USB, on LEONARDO, MICRO, YUN, and other 32u4 based boards.
+  while (!Serial) {
+    vTaskDelay(1);
+  }
+
+  for (;;)
+  {
+    StreamBufferSpans_t spans;
+
+    /**
+     * Get all the bytes in the stream buffer without copying them out.
+     */
+    size_t length = xStreamBufferAcquireRead(sampleStream, &spans, portMAX_DELAY);
+    if (length > 0) {
+      long sum = 0;
+      for (int span = 0; span < 2; span++) {
+        for (size_t i = 0; i < spans.xLength[span]; i++) {
+          sum += spans.pucData[span][i];
+        }
+      }
+
+      // Free the space for the writer.
+      vStreamBufferConsumeRead(sampleStream, length);
+
+      Serial.print("Samples: ");
+      Serial.print((unsigned) length);
+      Serial.print(" Average: ");
+      Serial.println(sum / (long) length);
+    }
+
+    char message[16];
+    size_t messageLength;
+    while ((messageLength = xMessageBufferReceive(logBuffer, message, sizeof(message) - 1, 0)) > 0) {
+      message[messageLength] = '\0';
+      Serial.print("Log: ");
+      Serial.println(message);
+    }
+  }
+}
+
+/*
+ * Blink task.
+ * See Blink_AnalogRead example.
+ */
+void TaskBlink(void *pvParameters)
+{
+  (void) pvParameters;
+
+  pinMode(LED_BUILTIN, OUTPUT);
+
+  for (;;)
+  {
+    digitalWrite(LED_BUILTIN, HIGH);
+    xMessageBufferSend(logBuffer, "led on", 6, 0);
+    vTaskDelay( 250 / portTICK_PERIOD_MS );
+    digitalWrite(LED_BUILTIN, LOW);
+    xMessageBufferSend(logBuffer, "led off", 7, 0);
+    vTaskDelay( 250 / portTICK_PERIOD_MS );
+  }
+}
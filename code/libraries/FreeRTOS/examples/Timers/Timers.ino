@@ -0,0 +1,119 @@
+/*
+ * Example of software timers and direct timers
+ * https://www.freertos.org/RTOS-software-timer.html
+ * Software timers run their callbacks in the timer service task; with
+ * configUSE_TIMER_WHEEL set to 1 they are kept on a timing wheel, so many
+ * running timers cost little to start and stop.
+ * Direct timers run their callbacks in the tick interrupt, and can fire
+ * part way into a tick. They need configUSE_DIRECT_TIMERS set to 1 in
+ * FreeRTOSConfig.h, which takes Timer3 from analogWrite() on pins 2, 3 and 5,
+ * Servo and tone().
+ */
+
+// Include Arduino FreeRTOS library
+#include <Arduino_FreeRTOS.h>
+
+// Include timer support
+#include <timers.h>
+#if ( configUSE_DIRECT_TIMERS == 1 )
+#include <direct_timer.h>
+#endif
+
+/*
+ * Declaring the global timer handles
+ * The blink timer toggles the LED, the report timer prints the pin A0 reading.
+ */
+TimerHandle_t blinkTimer;
+TimerHandle_t reportTimer;
+
+#if ( configUSE_DIRECT_TIMERS == 1 )
+/*
+ * A direct timer needs no heap; it is declared statically.
+ */
+static DirectTimer_t pulseTimer;
+#endif
+
+void setup() {
+
+  // Init Arduino serial
+  Serial.begin(9600);
+
+  pinMode(LED_BUILTIN, OUTPUT);
+
+  /**
+   * Create auto-reload software timers.
+   * https://www.freertos.org/FreeRTOS-timers-xTimerCreate.html
+   */
+  blinkTimer = xTimerCreate("Blink", // A name just for humans
+                            pdMS_TO_TICKS(250), // Period
+                            pdTRUE, // Auto-reload
+                            NULL, // Timer ID
+                            BlinkCallback);
+
+  reportTimer = xTimerCreate("Report", // A name just for humans
+                             pdMS_TO_TICKS(1000), // Period
+                             pdTRUE, // Auto-reload
+                             NULL, // Timer ID
+                             ReportCallback);
+
+  if (blinkTimer != NULL && reportTimer != NULL) {
+    // Start the timers. They run once the scheduler starts.
+    xTimerStart(blinkTimer, 0);
+    xTimerStart(reportTimer, 0);
+  }
+
+#if ( configUSE_DIRECT_TIMERS == 1 )
+  pinMode(7, OUTPUT);
+
+  /**
+   * Raise pin 7 on every second tick, and lower it 100 sub-tick counts
+   * (400us at 16MHz) after the tick that follows.
+   */
+  vDirectTimerInitialise(&pulseTimer, PulseCallback, NULL);
+  vDirectTimerStart(&pulseTimer, 1, 0, 2);
+#endif
+}
+
+void loop() {}
+
+
+/*
+ * Blink callback, run by the timer service task.
+ * Like any callback it must not block.
+ */
+void BlinkCallback(TimerHandle_t xTimer)
+{
+  (void) xTimer;
+
+  digitalWrite(LED_BUILTIN, !digitalRead(LED_BUILTIN));
+}
+
+/*
+ * Report callback, run by the timer service task.
+ */
+void ReportCallback(TimerHandle_t xTimer)
+{
+  (void) xTimer;
+
+  Serial.print("A0: ");
+  Serial.println(analogRead(A0));
+}
+
+#if ( configUSE_DIRECT_TIMERS == 1 )
+/*
+ * Pulse callback, run in the tick interrupt with interrupts disabled.
+ * It only touches the pin, and restarts itself to end or repeat the pulse.
+ */
+void PulseCallback(DirectTimer_t *pxTimer, BaseType_t *pxHigherPriorityTaskWoken)
+{
+  (void) pxHigherPriorityTaskWoken;
+
+  if (digitalRead(7) == LOW) {
+    digitalWrite(7, HIGH);
+    vDirectTimerStartFromISR(pxTimer, 1, 100, 0);
+  } else {
+    digitalWrite(7, LOW);
+    vDirectTimerStartFromISR(pxTimer, 1, 0, 2);
+  }
+}
+#endif
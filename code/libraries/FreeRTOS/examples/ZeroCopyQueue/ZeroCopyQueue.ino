@@ -0,0 +1,170 @@
+/*
+ * Example of zero-copy and batched queue access
+ * Items are built and read directly in the queue storage, and bursts of
+ * items are moved with a single call.
+ * Needs configUSE_QUEUE_ZERO_COPY set to 1 in FreeRTOSConfig.h.
+ */
+
+// Include Arduino FreeRTOS library
+#include <Arduino_FreeRTOS.h>
+
+// Include queue support
+#include <queue.h>
+
+// Define a struct
+struct pinRead {
+  int pin;
+  int value;
+};
+
+/*
+ * Declaring the global variables of type QueueHandle_t
+ * structQueue carries single readings built in place,
+ * sampleQueue carries bursts of raw samples.
+ */
+QueueHandle_t structQueue;
+QueueHandle_t sampleQueue;
+
+void setup() {
+
+  structQueue = xQueueCreate(4, // Queue length
+                             sizeof(struct pinRead) // Queue item size
+                             );
+
+  sampleQueue = xQueueCreate(16, // Queue length
+                             sizeof(int) // Queue item size
+                             );
+
+  if (structQueue != NULL && sampleQueue != NULL) {
+
+    // Create task that consumes both queues.
+    xTaskCreate(TaskSerial, // Task function
+                "Serial", // A name just for humans
+                128,  // This stack size can be checked & adjusted by reading the Stack Highwater
+                NULL,
+                2, // Priority, with 3 (configMAX_PRIORITIES - 1) being the highest, and 0 being the lowest.
+                NULL);
+
+    // Create task that builds readings in place.
+    xTaskCreate(TaskAnalogReadPin0, // Task function
+                "AnalogReadPin0", // Task name
+                128,  // Stack size
+                NULL,
+                1, // Priority
+                NULL);
+
+    // Create task that posts bursts of samples.
+    xTaskCreate(TaskAnalogBurstPin1, // Task function
+                "AnalogBurstPin1", // Task name
+                128,  // Stack size
+                NULL,
+                1, // Priority
+                NULL);
+  }
+}
+
+void loop() {}
+
+
+/**
+ * Analog read task for Pin A0
+ * Reserves the next slot of the queue, writes the reading straight into it
+ * and commits it, so the item is never copied.
+ */
+void TaskAnalogReadPin0(void *pvParameters)
+{
+  (void) pvParameters;
+
+  for (;;)
+  {
+    /**
+     * Reserve a slot at the back of the queue.
+     * The queue reads as full to other senders until the slot is committed.
+     */
+    struct pinRead *currentPinRead = (struct pinRead *) pvQueueReserve(structQueue, portMAX_DELAY);
+
+    currentPinRead->pin = 0;
+    currentPinRead->value = analogRead(A0);
+
+    // Post the reading.
+    vQueueCommit(structQueue);
+
+    vTaskDelay(10);
+  }
+}
+
+
+/**
+ * Analog burst task for Pin A1
+ * Takes eight samples and posts them with one call.
+ */
+void TaskAnalogBurstPin1(void *pvParameters)
+{
+  (void) pvParameters;
+
+  int samples[8];
+
+  for (;;)
+  {
+    for (int i = 0; i < 8; i++) {
+      samples[i] = analogRead(A1);
+    }
+
+    /**
+     * Post all eight samples under a single critical section.
+     * Returns the number of samples queued.
+     */
+    uxQueueSendMultiple(sampleQueue, samples, 8, portMAX_DELAY);
+
+    vTaskDelay(10);
+  }
+}
+
+/**
+ * Serial task.
+ * Prints the readings in place and averages the bursts.
+ */
+void TaskSerial(void * pvParameters) {
+  (void) pvParameters;
+
+  // Init Arduino serial
+  Serial.begin(9600);
+
+  // Wait for serial port to connect. Needed for native USB, on LEONARDO, MICRO, YUN, and other 32u4 based boards.
+  while (!Serial) {
+    vTaskDelay(1);
+  }
+
+  int samples[8];
+
+  for (;;)
+  {
+    /**
+     * Look at the front item without copying it out.
+     * It stays in the queue until it is released.
+     */
+    struct pinRead *currentPinRead = (struct pinRead *) pvQueuePeekInPlace(structQueue, 0);
+    if (currentPinRead != NULL) {
+      Serial.print("Pin: ");
+      Serial.print(currentPinRead->pin);
+      Serial.print(" Value: ");
+      Serial.println(currentPinRead->value);
+
+      // Remove the item and free its slot.
+      vQueueReleasePeeked(structQueue);
+    }
+
+    /**
+     * Take whatever samples are waiting, up to eight, with one call.
+     */
+    UBaseType_t count = uxQueueReceiveMultiple(sampleQueue, samples, 8, 1);
+    if (count > 0) {
+      long sum = 0;
+      for (UBaseType_t i = 0; i < count; i++) {
+        sum += samples[i];
+      }
+      Serial.print("Pin: 1 Average: ");
+      Serial.println(sum / (long) count);
+    }
+  }
+}
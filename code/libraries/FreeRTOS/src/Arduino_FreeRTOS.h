@@ -872,6 +872,82 @@
     #define configSUPPORT_DYNAMIC_ALLOCATION    1
 #endif
 
+#ifndef configUSE_KERNEL_BLOCK_POOLS
+    /* The pools are static RAM set aside up front: configTCB_POOL_LENGTH TCBs,
+     * configSTACK_POOL_LENGTH stacks of configSTACK_POOL_BLOCK_DEPTH words and
+     * configQUEUE_POOL_LENGTH queues. */
+    #define configUSE_KERNEL_BLOCK_POOLS    0
+#endif
+
+#ifndef configUSE_QUEUE_ZERO_COPY
+    #define configUSE_QUEUE_ZERO_COPY    0
+#endif
+
+#ifndef configUSE_DEADLINE_ORDERED_QUEUES
+    #define configUSE_DEADLINE_ORDERED_QUEUES    0
+#endif
+
+#ifndef configUSE_STREAM_BUFFER_ZERO_COPY
+    #define configUSE_STREAM_BUFFER_ZERO_COPY    0
+#endif
+
+#ifndef configUSE_STREAM_BUFFER_MULTI_PRODUCER
+    #define configUSE_STREAM_BUFFER_MULTI_PRODUCER    0
+#endif
+
+#ifndef configSTREAM_BUFFER_MAX_RESERVATIONS
+    #define configSTREAM_BUFFER_MAX_RESERVATIONS    4
+#endif
+
+#ifndef configUSE_TIMER_WHEEL
+    /* The wheel holds ( TickType_t bits / 4 ) * 16 lists in place of two: about
+     * 580 bytes of static RAM with 16 bit ticks. */
+    #define configUSE_TIMER_WHEEL    0
+#endif
+
+#ifndef configUSE_DIRECT_TIMERS
+    #define configUSE_DIRECT_TIMERS    0
+#endif
+
+#ifndef configUSE_EVENT_GROUP_WAITER_INDEX
+    /* The index gives every event group one waiter list and one mask per event
+     * bit in place of a single list: about 80 bytes more per group with 16 bit
+     * ticks. */
+    #define configUSE_EVENT_GROUP_WAITER_INDEX    0
+#endif
+
+#if ( configUSE_KERNEL_BLOCK_POOLS == 1 )
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+        #error configUSE_KERNEL_BLOCK_POOLS requires configSUPPORT_DYNAMIC_ALLOCATION to be 1
+    #endif
+
+    #ifndef configTCB_POOL_LENGTH
+        #define configTCB_POOL_LENGTH    4
+    #endif
+
+    #ifndef configSTACK_POOL_LENGTH
+        #define configSTACK_POOL_LENGTH    2
+    #endif
+
+    #ifndef configSTACK_POOL_BLOCK_DEPTH
+        #define configSTACK_POOL_BLOCK_DEPTH    configMINIMAL_STACK_SIZE
+    #endif
+
+    #ifndef configQUEUE_POOL_LENGTH
+        #define configQUEUE_POOL_LENGTH    2
+    #endif
+
+    #ifndef configQUEUE_POOL_STORAGE_BYTES
+        #define configQUEUE_POOL_STORAGE_BYTES    0
+    #endif
+
+    #if ( ( configTCB_POOL_LENGTH < 1 ) || ( configSTACK_POOL_LENGTH < 1 ) || ( configQUEUE_POOL_LENGTH < 1 ) )
+        #error Each kernel block pool must hold at least one block when configUSE_KERNEL_BLOCK_POOLS is 1
+    #endif
+
+#endif /* configUSE_KERNEL_BLOCK_POOLS */
+
 #ifndef configSTACK_DEPTH_TYPE
 
 /* Defaults to uint16_t for backward compatibility, but can be overridden
@@ -1227,6 +1303,18 @@ typedef struct xSTATIC_QUEUE
         UBaseType_t uxDummy8;
         uint8_t ucDummy9;
     #endif
+
+    #if ( configUSE_PRIORITY_CEILING_PROTOCOL == 1 )
+        UBaseType_t uxDummy10;
+    #endif
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        UBaseType_t uxDummy11[ 2 ];
+    #endif
+
+    #if ( configUSE_DEADLINE_ORDERED_QUEUES == 1 )
+        uint8_t ucDummy12;
+    #endif
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -1247,7 +1335,13 @@ typedef StaticQueue_t StaticSemaphore_t;
 typedef struct xSTATIC_EVENT_GROUP
 {
     TickType_t xDummy1;
-    StaticList_t xDummy2;
+
+    #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+        StaticList_t xDummy2[ ( configUSE_16_BIT_TICKS == 1 ) ? 8 : 24 ];
+        TickType_t xDummy5[ ( configUSE_16_BIT_TICKS == 1 ) ? 8 : 24 ];
+    #else
+        StaticList_t xDummy2;
+    #endif
 
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy3;
@@ -1307,6 +1401,10 @@ typedef struct xSTATIC_STREAM_BUFFER
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy4;
     #endif
+    #if ( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+        size_t uxDummy5[ 1 + configSTREAM_BUFFER_MAX_RESERVATIONS ];
+        uint8_t ucDummy6[ 3 ];
+    #endif
 } StaticStreamBuffer_t;
 
 /* Message buffers are built on stream buffers. */
@@ -69,16 +69,38 @@
 #define configUSE_COUNTING_SEMAPHORES       1
 #define configUSE_TIME_SLICING              1
 #define configUSE_QUEUE_SETS                0
+#define configUSE_QUEUE_ZERO_COPY           1
+#define configUSE_DEADLINE_ORDERED_QUEUES   1
+#define configUSE_STREAM_BUFFER_ZERO_COPY   1
+#define configUSE_STREAM_BUFFER_MULTI_PRODUCER 1
+#define configUSE_TIMER_WHEEL               0
+#define configUSE_EVENT_GROUP_WAITER_INDEX  0
 #define configUSE_MALLOC_FAILED_HOOK        1
 
 #define configSUPPORT_DYNAMIC_ALLOCATION    1
 #define configSUPPORT_STATIC_ALLOCATION     0
 
+/* Kernel block pool definitions.  TCBs, stacks of up to
+configSTACK_POOL_BLOCK_DEPTH words and queues with up to
+configQUEUE_POOL_STORAGE_BYTES bytes of storage (semaphores and mutexes need
+none) are taken from fixed-size pools first and from the heap only once the
+pool is empty.  Deeper stacks and larger queues always come from the heap.
+The pools below take about 1.6 KB of static RAM whether used or not: 1152
+bytes of stack blocks, about 340 bytes of TCBs and about 150 bytes of
+queues. */
+#define configUSE_KERNEL_BLOCK_POOLS        0
+#define configTCB_POOL_LENGTH               8
+#define configSTACK_POOL_LENGTH             6
+#define configSTACK_POOL_BLOCK_DEPTH        configMINIMAL_STACK_SIZE
+#define configQUEUE_POOL_LENGTH             4
+#define configQUEUE_POOL_STORAGE_BYTES      0
+
 /* Timer definitions. */
 #define configUSE_TIMERS                    1
 #define configTIMER_TASK_PRIORITY           ( ( UBaseType_t ) 3 )
 #define configTIMER_QUEUE_LENGTH            ( ( UBaseType_t ) 10 )
 #define configTIMER_TASK_STACK_DEPTH        ( 85 )
+#define configUSE_DIRECT_TIMERS             0
 
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES               0
@@ -52,6 +52,30 @@ extern "C" {
 //    xxx Watchdog Timer is 128kHz nominal, but 120 kHz at 5V DC and 25 degrees is actually more accurate, from data sheet.
 #define configTICK_RATE_HZ      ( (TickType_t)( (uint32_t)128000 >> (portUSE_WDTO + 11) ) )  // 2^11 = 2048 WDT scaler for 128kHz Timer
 
+// Sub-tick timer - places direct timer callbacks between ticks, when configUSE_DIRECT_TIMERS is 1.
+// Timer3 is restarted from zero on each tick that has a timer waiting for its offset, and counts CPU clocks divided by the prescaler.
+// The prescaler must be one of 8, 64, 256 or 1024, and leave fewer than 65536 counts per tick.
+//
+// WARNING: Timer3 is shared with the Arduino core. While a direct timer waits for its offset, Timer3 is reprogrammed,
+// so analogWrite() on pins 2, 3 and 5 of a Mega stops, and so does anything else driven by Timer3, such as Servo or tone()
+// when they are set up to use it. Its settings are restored once the last offset of the tick has passed.
+// Direct timers with an offset of 0 never touch Timer3.
+//
+// Devices without Timer3, such as the ATmega328P of the Uno, have no sub-tick timer. Direct timers still fire on their
+// tick there, but every offset must be 0.
+
+#ifndef portSUB_TICK_PRESCALER
+    #define portSUB_TICK_PRESCALER  64      // 4us per count at 16MHz
+#endif
+
+#if defined( TCCR3B )
+    #define portHAS_SUB_TICK_TIMER          1
+    #define portSUB_TICK_COUNTS_PER_TICK    ( (uint16_t)( ( configCPU_CLOCK_HZ / portSUB_TICK_PRESCALER ) / configTICK_RATE_HZ ) )
+#else
+    #define portHAS_SUB_TICK_TIMER          0
+    #define portSUB_TICK_COUNTS_PER_TICK    ( (uint16_t) 1 )    // Only an offset of 0 is valid.
+#endif
+
 /*-----------------------------------------------------------*/
 
 #ifndef INC_TASK_H
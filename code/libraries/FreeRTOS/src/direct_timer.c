@@ -0,0 +1,388 @@
+/*
+ * FreeRTOS Kernel V10.4.3
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "Arduino_FreeRTOS.h"
+#include "task.h"
+#include "direct_timer.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include direct timers.  This #if is closed at the very bottom of this file. */
+#if ( configUSE_DIRECT_TIMERS == 1 )
+
+/* Values of the ucState member of a timer. */
+    #define dtmSTATE_IDLE       ( ( uint8_t ) 0 ) /* Not on any list. */
+    #define dtmSTATE_PENDING    ( ( uint8_t ) 1 ) /* Waiting for its tick, on pxPendingTimers. */
+    #define dtmSTATE_DUE        ( ( uint8_t ) 2 ) /* Waiting for its sub-tick offset, on pxDueTimers. */
+
+/*lint -save -e956 A manual analysis and inspection has been used to determine
+ * which static variables must be declared volatile. */
+
+/* Timers waiting for their tick, in the order they fall due.  Each xDelta is
+ * relative to the timer in front, so the front timer's xDelta is the number of
+ * ticks until it is due. */
+    PRIVILEGED_DATA static DirectTimer_t * pxPendingTimers = NULL;
+
+/* Timers that are due on the current tick but have not yet reached their
+ * sub-tick offset, in offset order. */
+    PRIVILEGED_DATA static DirectTimer_t * pxDueTimers = NULL;
+
+/*lint -restore */
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Places the timer on the pending list so it falls due xTicks ticks from now.
+ * Must be called with interrupts masked.
+ */
+    static void prvInsertPendingTimer( DirectTimer_t * const pxTimer,
+                                       TickType_t xTicks ) PRIVILEGED_FUNCTION;
+
+/*
+ * Takes the timer off whichever list it is on.  Must be called with interrupts
+ * masked.
+ */
+    static void prvRemoveTimer( DirectTimer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Reloads the timer if it is periodic, then calls its callback.
+ */
+    static void prvFireTimer( DirectTimer_t * const pxTimer,
+                              BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    void vDirectTimerInitialise( DirectTimer_t * pxTimer,
+                                 DirectTimerCallbackFunction_t pxCallbackFunction,
+                                 void * pvTimerID )
+    {
+        configASSERT( pxTimer );
+        configASSERT( pxCallbackFunction );
+
+        pxTimer->pxNext = NULL;
+        pxTimer->pxCallbackFunction = pxCallbackFunction;
+        pxTimer->pvTimerID = pvTimerID;
+        pxTimer->xDelta = ( TickType_t ) 0U;
+        pxTimer->xPeriodInTicks = ( TickType_t ) 0U;
+        pxTimer->usSubTickOffset = 0U;
+        pxTimer->ucState = dtmSTATE_IDLE;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvInsertPendingTimer( DirectTimer_t * const pxTimer,
+                                       TickType_t xTicks )
+    {
+        DirectTimer_t ** ppxLink = &pxPendingTimers;
+
+        /* Skip the timers that fall due on or before the same tick, so timers
+         * due on the same tick fire in the order they were started. */
+        while( ( *ppxLink != NULL ) && ( ( *ppxLink )->xDelta <= xTicks ) )
+        {
+            xTicks -= ( *ppxLink )->xDelta;
+            ppxLink = &( ( *ppxLink )->pxNext );
+        }
+
+        if( *ppxLink != NULL )
+        {
+            ( *ppxLink )->xDelta -= xTicks;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxTimer->xDelta = xTicks;
+        pxTimer->pxNext = *ppxLink;
+        pxTimer->ucState = dtmSTATE_PENDING;
+        *ppxLink = pxTimer;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRemoveTimer( DirectTimer_t * const pxTimer )
+    {
+        DirectTimer_t ** ppxLink;
+
+        if( pxTimer->ucState == dtmSTATE_PENDING )
+        {
+            ppxLink = &pxPendingTimers;
+        }
+        else if( pxTimer->ucState == dtmSTATE_DUE )
+        {
+            ppxLink = &pxDueTimers;
+        }
+        else
+        {
+            return;
+        }
+
+        while( *ppxLink != pxTimer )
+        {
+            configASSERT( *ppxLink );
+            ppxLink = &( ( *ppxLink )->pxNext );
+        }
+
+        *ppxLink = pxTimer->pxNext;
+
+        /* The timer behind inherits the removed timer's delta, so it still
+         * falls due on the same tick. */
+        if( ( pxTimer->ucState == dtmSTATE_PENDING ) && ( pxTimer->pxNext != NULL ) )
+        {
+            pxTimer->pxNext->xDelta += pxTimer->xDelta;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxTimer->pxNext = NULL;
+        pxTimer->ucState = dtmSTATE_IDLE;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvFireTimer( DirectTimer_t * const pxTimer,
+                              BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        /* Reload before the callback so the callback can stop or restart the
+         * timer. */
+        if( pxTimer->xPeriodInTicks != ( TickType_t ) 0U )
+        {
+            prvInsertPendingTimer( pxTimer, pxTimer->xPeriodInTicks );
+        }
+        else
+        {
+            pxTimer->pxNext = NULL;
+            pxTimer->ucState = dtmSTATE_IDLE;
+        }
+
+        pxTimer->pxCallbackFunction( pxTimer, pxHigherPriorityTaskWoken );
+    }
+/*-----------------------------------------------------------*/
+
+    void vDirectTimerStartFromISR( DirectTimer_t * pxTimer,
+                                   TickType_t xTicks,
+                                   uint16_t usSubTickOffset,
+                                   TickType_t xPeriodInTicks )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( pxTimer );
+        configASSERT( xTicks > ( TickType_t ) 0U );
+        configASSERT( usSubTickOffset < portSUB_TICK_COUNTS_PER_TICK );
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            prvRemoveTimer( pxTimer );
+            pxTimer->usSubTickOffset = usSubTickOffset;
+            pxTimer->xPeriodInTicks = xPeriodInTicks;
+            prvInsertPendingTimer( pxTimer, xTicks );
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    void vDirectTimerStart( DirectTimer_t * pxTimer,
+                            TickType_t xTicks,
+                            uint16_t usSubTickOffset,
+                            TickType_t xPeriodInTicks )
+    {
+        configASSERT( pxTimer );
+        configASSERT( xTicks > ( TickType_t ) 0U );
+        configASSERT( usSubTickOffset < portSUB_TICK_COUNTS_PER_TICK );
+
+        taskENTER_CRITICAL();
+        {
+            prvRemoveTimer( pxTimer );
+            pxTimer->usSubTickOffset = usSubTickOffset;
+            pxTimer->xPeriodInTicks = xPeriodInTicks;
+            prvInsertPendingTimer( pxTimer, xTicks );
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    void vDirectTimerStopFromISR( DirectTimer_t * pxTimer )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( pxTimer );
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            prvRemoveTimer( pxTimer );
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    void vDirectTimerStop( DirectTimer_t * pxTimer )
+    {
+        configASSERT( pxTimer );
+
+        taskENTER_CRITICAL();
+        {
+            prvRemoveTimer( pxTimer );
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xDirectTimerIsActive( DirectTimer_t * pxTimer )
+    {
+        configASSERT( pxTimer );
+
+        /* A single byte, so it is read atomically. */
+        return ( pxTimer->ucState != dtmSTATE_IDLE ) ? pdTRUE : pdFALSE;
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvDirectTimerGetTimerID( DirectTimer_t * pxTimer )
+    {
+        configASSERT( pxTimer );
+
+        return pxTimer->pvTimerID;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xDirectTimerProcessTick( void )
+    {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        DirectTimer_t * pxTimer;
+        DirectTimer_t ** ppxLink;
+
+        /* Any timer still waiting for its offset is late, as the sub-tick timer
+         * ran past the real length of the last tick.  Fire it now rather than
+         * let it slip a whole tick. */
+        while( pxDueTimers != NULL )
+        {
+            pxTimer = pxDueTimers;
+            pxDueTimers = pxTimer->pxNext;
+            prvFireTimer( pxTimer, &xHigherPriorityTaskWoken );
+        }
+
+        if( pxPendingTimers != NULL )
+        {
+            pxPendingTimers->xDelta--;
+
+            /* Timers behind the front with a delta of 0 are due on the same
+             * tick.  A reloaded timer always has a delta of at least 1, so it
+             * cannot be taken again here. */
+            while( ( pxPendingTimers != NULL ) && ( pxPendingTimers->xDelta == ( TickType_t ) 0U ) )
+            {
+                pxTimer = pxPendingTimers;
+                pxPendingTimers = pxTimer->pxNext;
+
+                if( pxTimer->usSubTickOffset == 0U )
+                {
+                    prvFireTimer( pxTimer, &xHigherPriorityTaskWoken );
+                }
+                else
+                {
+                    /* Keep the due timers in offset order, later timers with
+                     * the same offset going behind earlier ones. */
+                    ppxLink = &pxDueTimers;
+
+                    while( ( *ppxLink != NULL ) && ( ( *ppxLink )->usSubTickOffset <= pxTimer->usSubTickOffset ) )
+                    {
+                        ppxLink = &( ( *ppxLink )->pxNext );
+                    }
+
+                    pxTimer->pxNext = *ppxLink;
+                    pxTimer->ucState = dtmSTATE_DUE;
+                    *ppxLink = pxTimer;
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The sub-tick timer is restarted from this tick, or stopped if no
+         * timer needs it; the port leaves Timer3 alone if it was not running. */
+        #if ( portHAS_SUB_TICK_TIMER == 1 )
+            if( pxDueTimers != NULL )
+            {
+                vPortStartSubTickTimer( pxDueTimers->usSubTickOffset );
+            }
+            else
+            {
+                vPortStopSubTickTimer();
+            }
+        #endif /* portHAS_SUB_TICK_TIMER */
+
+        return xHigherPriorityTaskWoken;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( portHAS_SUB_TICK_TIMER == 1 )
+
+    BaseType_t xDirectTimerProcessSubTick( void )
+    {
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        DirectTimer_t * pxTimer;
+
+        for( ; ; )
+        {
+            while( ( pxDueTimers != NULL ) && ( pxDueTimers->usSubTickOffset <= usPortGetSubTickCount() ) )
+            {
+                pxTimer = pxDueTimers;
+                pxDueTimers = pxTimer->pxNext;
+                prvFireTimer( pxTimer, &xHigherPriorityTaskWoken );
+            }
+
+            if( pxDueTimers == NULL )
+            {
+                vPortStopSubTickTimer();
+                break;
+            }
+
+            /* The compare only matches on equality, so if the count passed the
+             * next offset while the callbacks ran, go round again instead. */
+            vPortSetSubTickCompare( pxDueTimers->usSubTickOffset );
+
+            if( pxDueTimers->usSubTickOffset > usPortGetSubTickCount() )
+            {
+                break;
+            }
+        }
+
+        return xHigherPriorityTaskWoken;
+    }
+
+    #endif /* portHAS_SUB_TICK_TIMER */
+
+#endif /* configUSE_DIRECT_TIMERS == 1 */
@@ -0,0 +1,214 @@
+/*
+ * FreeRTOS Kernel V10.4.3
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Direct timers call their callback from the tick interrupt rather than from
+ * the timer service task, so the callback does not wait for a command to pass
+ * through the timer queue, or for the timer service task to be scheduled.
+ * Each timer can also be given an offset, in counts of the port's sub-tick
+ * timer, at which to fire after the tick on which it falls due.  On this port
+ * the sub-tick timer is Timer3, counting in steps of portSUB_TICK_PRESCALER CPU
+ * clocks; see FreeRTOSVariant.h for what else uses Timer3.  Devices without
+ * Timer3 have no sub-tick timer, and every offset must be 0.
+ *
+ * configUSE_DIRECT_TIMERS must be set to 1 in FreeRTOSConfig.h for direct
+ * timers to be available.
+ *
+ * ***NOTE***:  Callbacks execute in interrupt context with interrupts disabled.
+ * They must be short, must not block, and may only call API functions that end
+ * in "FromISR".  A callback that unblocks a task should set
+ * *pxHigherPriorityTaskWoken to pdTRUE if that task has a higher priority than
+ * the interrupted one, in which case a context switch is performed as the
+ * interrupt exits.
+ *
+ * Timers waiting for their tick are held in a delta list, each storing the
+ * number of ticks after the one in front of it, so the tick interrupt only ever
+ * looks at the front of the list.  Starting and stopping a timer walks the list.
+ */
+
+#ifndef DIRECT_TIMER_H
+#define DIRECT_TIMER_H
+
+#ifndef INC_ARDUINO_FREERTOS_H
+    #error "include Arduino_FreeRTOS.h must appear in source files before include direct_timer.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+struct DirectTimerDefinition;
+
+/*
+ * Prototype of the function called when a direct timer fires.
+ */
+typedef void (* DirectTimerCallbackFunction_t)( struct DirectTimerDefinition * pxTimer,
+                                               BaseType_t * pxHigherPriorityTaskWoken );
+
+/*
+ * The timer itself.  It is declared here so timers need no dynamic memory;
+ * its members must only be accessed through the functions below.
+ */
+typedef struct DirectTimerDefinition
+{
+    struct DirectTimerDefinition * pxNext;            /*< Next timer in the list this timer is on. */
+    DirectTimerCallbackFunction_t pxCallbackFunction; /*< Called when the timer fires. */
+    void * pvTimerID;                                 /*< Identifies the timer when one callback serves several timers. */
+    TickType_t xDelta;                                /*< Ticks after the timer in front of it in the pending list. */
+    TickType_t xPeriodInTicks;                        /*< Ticks between firings, or 0 for a one-shot timer. */
+    uint16_t usSubTickOffset;                         /*< Sub-tick timer counts after the tick at which to fire. */
+    uint8_t ucState;                                  /*< Which list, if any, the timer is on. */
+} DirectTimer_t;
+
+/**
+ * direct_timer.h
+ *
+ * <pre>
+ * void vDirectTimerInitialise( DirectTimer_t *pxTimer, DirectTimerCallbackFunction_t pxCallbackFunction, void *pvTimerID );
+ * </pre>
+ *
+ * Prepares a timer for use.  The timer is not started.
+ */
+void vDirectTimerInitialise( DirectTimer_t * pxTimer,
+                             DirectTimerCallbackFunction_t pxCallbackFunction,
+                             void * pvTimerID ) PRIVILEGED_FUNCTION;
+
+/**
+ * direct_timer.h
+ *
+ * <pre>
+ * void vDirectTimerStart( DirectTimer_t *pxTimer, TickType_t xTicks, uint16_t usSubTickOffset, TickType_t xPeriodInTicks );
+ * </pre>
+ *
+ * Starts the timer, or restarts it if it is already running.  The timer falls
+ * due on the xTicks'th tick from now, so xTicks must be at least 1, and fires
+ * usSubTickOffset sub-tick counts after that tick.  The offset must be less than
+ * portSUB_TICK_COUNTS_PER_TICK.  If xPeriodInTicks is not 0 the timer then fires
+ * again every xPeriodInTicks ticks, at the same offset, until it is stopped.
+ *
+ * Example usage:
+ * <pre>
+ * static DirectTimer_t xPulseTimer;
+ *
+ * static void prvPulseEnd( DirectTimer_t *pxTimer, BaseType_t *pxHigherPriorityTaskWoken )
+ * {
+ *     PORTB &= ~_BV( PB5 );
+ * }
+ *
+ * void vStartPulse( void )
+ * {
+ *     vDirectTimerInitialise( &xPulseTimer, prvPulseEnd, NULL );
+ *
+ *     // End the pulse 250 sub-tick counts after the second tick from now.
+ *     PORTB |= _BV( PB5 );
+ *     vDirectTimerStart( &xPulseTimer, 2, 250, 0 );
+ * }
+ * </pre>
+ */
+void vDirectTimerStart( DirectTimer_t * pxTimer,
+                        TickType_t xTicks,
+                        uint16_t usSubTickOffset,
+                        TickType_t xPeriodInTicks ) PRIVILEGED_FUNCTION;
+
+/**
+ * direct_timer.h
+ *
+ * <pre>
+ * void vDirectTimerStartFromISR( DirectTimer_t *pxTimer, TickType_t xTicks, uint16_t usSubTickOffset, TickType_t xPeriodInTicks );
+ * </pre>
+ *
+ * A version of vDirectTimerStart() that can be called from an interrupt,
+ * including from a direct timer callback.
+ */
+void vDirectTimerStartFromISR( DirectTimer_t * pxTimer,
+                               TickType_t xTicks,
+                               uint16_t usSubTickOffset,
+                               TickType_t xPeriodInTicks ) PRIVILEGED_FUNCTION;
+
+/**
+ * direct_timer.h
+ *
+ * <pre>
+ * void vDirectTimerStop( DirectTimer_t *pxTimer );
+ * </pre>
+ *
+ * Stops the timer.  Does nothing if the timer is not running.
+ */
+void vDirectTimerStop( DirectTimer_t * pxTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * direct_timer.h
+ *
+ * <pre>
+ * void vDirectTimerStopFromISR( DirectTimer_t *pxTimer );
+ * </pre>
+ *
+ * A version of vDirectTimerStop() that can be called from an interrupt,
+ * including from a direct timer callback.
+ */
+void vDirectTimerStopFromISR( DirectTimer_t * pxTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * direct_timer.h
+ *
+ * <pre>
+ * BaseType_t xDirectTimerIsActive( DirectTimer_t *pxTimer );
+ * </pre>
+ *
+ * @return pdTRUE if the timer is waiting to fire, otherwise pdFALSE.
+ */
+BaseType_t xDirectTimerIsActive( DirectTimer_t * pxTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * direct_timer.h
+ *
+ * <pre>
+ * void *pvDirectTimerGetTimerID( DirectTimer_t *pxTimer );
+ * </pre>
+ *
+ * @return The pvTimerID the timer was initialised with.
+ */
+void * pvDirectTimerGetTimerID( DirectTimer_t * pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * THE FOLLOWING FUNCTIONS ARE FOR THE KERNEL AND PORT LAYER ONLY.
+ *
+ * xDirectTimerProcessTick() is called by xTaskIncrementTick() on every tick,
+ * and xDirectTimerProcessSubTick() by the port's sub-tick timer interrupt.
+ * Both return pdTRUE if a callback unblocked a task that should run next.
+ */
+BaseType_t xDirectTimerProcessTick( void ) PRIVILEGED_FUNCTION;
+BaseType_t xDirectTimerProcessSubTick( void ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( DIRECT_TIMER_H ) */
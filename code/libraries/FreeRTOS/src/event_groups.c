@@ -52,17 +52,25 @@
     #define eventUNBLOCKED_DUE_TO_BIT_SET    0x0200U
     #define eventWAIT_FOR_ALL_BITS           0x0400U
     #define eventEVENT_BITS_CONTROL_BYTES    0xff00U
+    #define eventWAITER_LISTS                8U
 #else
     #define eventCLEAR_EVENTS_ON_EXIT_BIT    0x01000000UL
     #define eventUNBLOCKED_DUE_TO_BIT_SET    0x02000000UL
     #define eventWAIT_FOR_ALL_BITS           0x04000000UL
     #define eventEVENT_BITS_CONTROL_BYTES    0xff000000UL
+    #define eventWAITER_LISTS                24U
 #endif
 
 typedef struct EventGroupDef_t
 {
     EventBits_t uxEventBits;
-    List_t xTasksWaitingForBits; /*< List of tasks waiting for a bit to be set. */
+
+    #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+        List_t xTasksWaitingForBits[ eventWAITER_LISTS ]; /*< Tasks waiting for bits to be set, listed by the lowest bit they wait for. */
+        EventBits_t uxAnyBitsWaitedFor[ eventWAITER_LISTS ]; /*< Union of the bits waited for by the wait-for-any tasks on each list.  Only ever too wide, never too narrow. */
+    #else
+        List_t xTasksWaitingForBits; /*< List of tasks waiting for a bit to be set. */
+    #endif
 
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxEventGroupNumber;
@@ -73,6 +81,16 @@ typedef struct EventGroupDef_t
     #endif
 } EventGroup_t;
 
+/* Access to the waiting task lists that works whether or not they are
+ * indexed. */
+#if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+    #define eventWAITER_LIST_COUNT                          eventWAITER_LISTS
+    #define eventGET_WAITER_LIST( pxEventBits, uxList )    ( &( ( pxEventBits )->xTasksWaitingForBits[ ( uxList ) ] ) )
+#else
+    #define eventWAITER_LIST_COUNT                          1U
+    #define eventGET_WAITER_LIST( pxEventBits, uxList )    ( &( ( pxEventBits )->xTasksWaitingForBits ) )
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -87,6 +105,33 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
                                         const EventBits_t uxBitsToWaitFor,
                                         const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Initialise the list, or lists, of tasks waiting for bits in the event group.
+ */
+static void prvInitialiseWaiterLists( EventGroup_t * const pxEventBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the list a task waiting for uxBitsToWaitFor should be placed on.
+ * With configUSE_EVENT_GROUP_WAITER_INDEX set to 1 that is the list for the
+ * lowest bit in uxBitsToWaitFor.  A task waiting for all its bits cannot be
+ * unblocked until that bit is set; a task waiting for any of its bits is also
+ * recorded in the list's uxAnyBitsWaitedFor.
+ */
+static List_t * prvSelectWaiterList( EventGroup_t * const pxEventBits,
+                                     const EventBits_t uxBitsToWaitFor,
+                                     const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock the tasks on pxList whose wait condition is met by the current event
+ * bits, and return the bits that must be cleared because one of those tasks
+ * asked for its bits to be cleared on exit.  If puxAnyBitsStillWaitedFor is not
+ * NULL it is set to the union of the bits waited for by the wait-for-any tasks
+ * that remain on the list.
+ */
+static EventBits_t prvUnblockWaitingTasks( EventGroup_t * const pxEventBits,
+                                           const List_t * const pxList,
+                                           EventBits_t * const puxAnyBitsStillWaitedFor ) PRIVILEGED_FUNCTION;
+
 /*-----------------------------------------------------------*/
 
 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -114,7 +159,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
         if( pxEventBits != NULL )
         {
             pxEventBits->uxEventBits = 0;
-            vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+            prvInitialiseWaiterLists( pxEventBits );
 
             #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
                 {
@@ -165,7 +210,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
         if( pxEventBits != NULL )
         {
             pxEventBits->uxEventBits = 0;
-            vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+            prvInitialiseWaiterLists( pxEventBits );
 
             #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                 {
@@ -233,7 +278,7 @@ EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup,
                 /* Store the bits that the calling task is waiting for in the
                  * task's event list item so the kernel knows when a match is
                  * found.  Then enter the blocked state. */
-                vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+                vTaskPlaceOnUnorderedEventList( prvSelectWaiterList( pxEventBits, uxBitsToWaitFor, pdTRUE ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
 
                 /* This assignment is obsolete as uxReturn will get set after
                  * the task unblocks, but some compilers mistakenly generate a
@@ -392,7 +437,7 @@ EventBits_t xEventGroupWaitBits( EventGroupHandle_t xEventGroup,
             /* Store the bits that the calling task is waiting for in the
              * task's event list item so the kernel knows when a match is
              * found.  Then enter the blocked state. */
-            vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+            vTaskPlaceOnUnorderedEventList( prvSelectWaiterList( pxEventBits, uxBitsToWaitFor, xWaitForAllBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
 
             /* This is obsolete as it will get set after the task unblocks, but
              * some compilers mistakenly generate a warning about the variable
@@ -531,87 +576,47 @@ EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup )
 EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
                                 const EventBits_t uxBitsToSet )
 {
-    ListItem_t * pxListItem, * pxNext;
-    ListItem_t const * pxListEnd;
-    List_t const * pxList;
-    EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
+    EventBits_t uxBitsToClear = 0;
     EventGroup_t * pxEventBits = xEventGroup;
-    BaseType_t xMatchFound = pdFALSE;
 
     /* Check the user is not attempting to set the bits used by the kernel
      * itself. */
     configASSERT( xEventGroup );
     configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-    pxList = &( pxEventBits->xTasksWaitingForBits );
-    pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
     vTaskSuspendAll();
     {
         traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
 
-        pxListItem = listGET_HEAD_ENTRY( pxList );
-
         /* Set the bits. */
         pxEventBits->uxEventBits |= uxBitsToSet;
 
         /* See if the new bit value should unblock any tasks. */
-        while( pxListItem != pxListEnd )
-        {
-            pxNext = listGET_NEXT( pxListItem );
-            uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
-            xMatchFound = pdFALSE;
-
-            /* Split the bits waited for from the control bits. */
-            uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
-            uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
-
-            if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+        #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
             {
-                /* Just looking for single bit being set. */
-                if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
-                {
-                    xMatchFound = pdTRUE;
-                }
-                else
+                UBaseType_t uxList;
+
+                /* Only visit the lists that can hold a task that is now
+                 * satisfied - those whose own bit is set, or whose wait-for-any
+                 * tasks wait for a bit that is set. */
+                for( uxList = 0; uxList < eventWAITER_LISTS; uxList++ )
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    if( ( ( pxEventBits->uxEventBits & ( ( EventBits_t ) 1 << uxList ) ) != ( EventBits_t ) 0 ) ||
+                        ( ( pxEventBits->uxEventBits & pxEventBits->uxAnyBitsWaitedFor[ uxList ] ) != ( EventBits_t ) 0 ) )
+                    {
+                        uxBitsToClear |= prvUnblockWaitingTasks( pxEventBits, eventGET_WAITER_LIST( pxEventBits, uxList ), &( pxEventBits->uxAnyBitsWaitedFor[ uxList ] ) );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
             }
-            else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+        #else
             {
-                /* All bits are set. */
-                xMatchFound = pdTRUE;
+                uxBitsToClear = prvUnblockWaitingTasks( pxEventBits, eventGET_WAITER_LIST( pxEventBits, 0U ), NULL );
             }
-            else
-            {
-                /* Need all bits to be set, but not all the bits were set. */
-            }
-
-            if( xMatchFound != pdFALSE )
-            {
-                /* The bits match.  Should the bits be cleared on exit? */
-                if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
-                {
-                    uxBitsToClear |= uxBitsWaitedFor;
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-
-                /* Store the actual event flag value in the task's event list
-                 * item before removing the task from the event list.  The
-                 * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
-                 * that is was unblocked due to its required bits matching, rather
-                 * than because it timed out. */
-                vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
-            }
-
-            /* Move onto the next list item.  Note pxListItem->pxNext is not
-             * used here as the list item may have been removed from the event list
-             * and inserted into the ready/pending reading list. */
-            pxListItem = pxNext;
-        }
+        #endif /* configUSE_EVENT_GROUP_WAITER_INDEX */
 
         /* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
          * bit was set in the control word. */
@@ -626,18 +631,24 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
 void vEventGroupDelete( EventGroupHandle_t xEventGroup )
 {
     EventGroup_t * pxEventBits = xEventGroup;
-    const List_t * pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
+    const List_t * pxTasksWaitingForBits;
+    UBaseType_t uxList;
 
     vTaskSuspendAll();
     {
         traceEVENT_GROUP_DELETE( xEventGroup );
 
-        while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+        for( uxList = 0; uxList < eventWAITER_LIST_COUNT; uxList++ )
         {
-            /* Unblock the task, returning 0 as the event list is being deleted
-             * and cannot therefore have any bits set. */
-            configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
-            vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+            pxTasksWaitingForBits = eventGET_WAITER_LIST( pxEventBits, uxList );
+
+            while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+            {
+                /* Unblock the task, returning 0 as the event list is being deleted
+                 * and cannot therefore have any bits set. */
+                configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
+                vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+            }
         }
 
         #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
@@ -683,6 +694,140 @@ void vEventGroupClearBitsCallback( void * pvEventGroup,
 }
 /*-----------------------------------------------------------*/
 
+static void prvInitialiseWaiterLists( EventGroup_t * const pxEventBits )
+{
+    UBaseType_t uxList;
+
+    for( uxList = 0; uxList < eventWAITER_LIST_COUNT; uxList++ )
+    {
+        vListInitialise( eventGET_WAITER_LIST( pxEventBits, uxList ) );
+
+        #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+            {
+                pxEventBits->uxAnyBitsWaitedFor[ uxList ] = 0;
+            }
+        #endif
+    }
+}
+/*-----------------------------------------------------------*/
+
+static List_t * prvSelectWaiterList( EventGroup_t * const pxEventBits,
+                                     const EventBits_t uxBitsToWaitFor,
+                                     const BaseType_t xWaitForAllBits )
+{
+    #if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 )
+        {
+            UBaseType_t uxList = 0;
+
+            while( ( uxBitsToWaitFor & ( ( EventBits_t ) 1 << uxList ) ) == ( EventBits_t ) 0 )
+            {
+                uxList++;
+            }
+
+            if( xWaitForAllBits == pdFALSE )
+            {
+                pxEventBits->uxAnyBitsWaitedFor[ uxList ] |= uxBitsToWaitFor;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return eventGET_WAITER_LIST( pxEventBits, uxList );
+        }
+    #else /* if ( configUSE_EVENT_GROUP_WAITER_INDEX == 1 ) */
+        {
+            ( void ) uxBitsToWaitFor;
+            ( void ) xWaitForAllBits;
+
+            return eventGET_WAITER_LIST( pxEventBits, 0U );
+        }
+    #endif /* configUSE_EVENT_GROUP_WAITER_INDEX */
+}
+/*-----------------------------------------------------------*/
+
+static EventBits_t prvUnblockWaitingTasks( EventGroup_t * const pxEventBits,
+                                           const List_t * const pxList,
+                                           EventBits_t * const puxAnyBitsStillWaitedFor )
+{
+    ListItem_t * pxListItem, * pxNext;
+    ListItem_t const * pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+    EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits, uxAnyBitsStillWaitedFor = 0;
+    BaseType_t xMatchFound;
+
+    pxListItem = listGET_HEAD_ENTRY( pxList );
+
+    while( pxListItem != pxListEnd )
+    {
+        pxNext = listGET_NEXT( pxListItem );
+        uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+        xMatchFound = pdFALSE;
+
+        /* Split the bits waited for from the control bits. */
+        uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+        uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+        if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+        {
+            /* Just looking for single bit being set. */
+            if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+            {
+                xMatchFound = pdTRUE;
+            }
+            else
+            {
+                uxAnyBitsStillWaitedFor |= uxBitsWaitedFor;
+            }
+        }
+        else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+        {
+            /* All bits are set. */
+            xMatchFound = pdTRUE;
+        }
+        else
+        {
+            /* Need all bits to be set, but not all the bits were set. */
+        }
+
+        if( xMatchFound != pdFALSE )
+        {
+            /* The bits match.  Should the bits be cleared on exit? */
+            if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+            {
+                uxBitsToClear |= uxBitsWaitedFor;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Store the actual event flag value in the task's event list
+             * item before removing the task from the event list.  The
+             * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
+             * that is was unblocked due to its required bits matching, rather
+             * than because it timed out. */
+            vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+        }
+
+        /* Move onto the next list item.  Note pxListItem->pxNext is not
+         * used here as the list item may have been removed from the event list
+         * and inserted into the ready/pending reading list. */
+        pxListItem = pxNext;
+    }
+
+    if( puxAnyBitsStillWaitedFor != NULL )
+    {
+        *puxAnyBitsStillWaitedFor = uxAnyBitsStillWaitedFor;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return uxBitsToClear;
+}
+/*-----------------------------------------------------------*/
+
 static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
                                         const EventBits_t uxBitsToWaitFor,
                                         const BaseType_t xWaitForAllBits )
@@ -51,6 +51,37 @@
 
 #if( configSUPPORT_DYNAMIC_ALLOCATION > 0 )
 
+#if defined( __AVR__ )
+
+/* avr-libc keeps released chunks on a free list below __brkval and hands out
+ * fresh memory by moving __brkval up towards __malloc_heap_end.  Both are
+ * walked to report heap usage. */
+    struct __freelist
+    {
+        size_t sz;
+        struct __freelist * nx;
+    };
+
+    extern struct __freelist * __flp;
+    extern char * __brkval;
+    extern char * __malloc_heap_start;
+    extern char * __malloc_heap_end;
+    extern size_t __malloc_margin;
+
+/* Lowest value returned by prvHeapFreeBytes() since boot. */
+    static size_t xMinimumEverFreeBytesRemaining = ( size_t ) -1;
+    static size_t xNumberOfSuccessfulAllocations = 0;
+    static size_t xNumberOfSuccessfulFrees = 0;
+
+/* Returns the total number of free heap bytes and, optionally, the largest
+ * free block and the number of free blocks.  Must be called with the
+ * scheduler suspended. */
+    static size_t prvHeapFreeBytes( size_t * pxLargestFreeBlock,
+                                    size_t * pxSmallestFreeBlock,
+                                    size_t * pxNumberOfFreeBlocks );
+
+#endif /* __AVR__ */
+
 /*-----------------------------------------------------------*/
 
 void * pvPortMalloc( size_t xWantedSize )
@@ -61,6 +92,20 @@ void * pvPortMalloc( size_t xWantedSize )
     {
         pvReturn = malloc( xWantedSize );
         traceMALLOC( pvReturn, xWantedSize );
+
+        #if defined( __AVR__ )
+            if( pvReturn != NULL )
+            {
+                size_t xFreeBytes = prvHeapFreeBytes( NULL, NULL, NULL );
+
+                if( xFreeBytes < xMinimumEverFreeBytesRemaining )
+                {
+                    xMinimumEverFreeBytesRemaining = xFreeBytes;
+                }
+
+                xNumberOfSuccessfulAllocations++;
+            }
+        #endif /* __AVR__ */
     }
     ( void ) xTaskResumeAll();
 
@@ -86,9 +131,182 @@ void vPortFree( void * pv )
         {
             free( pv );
             traceFREE( pv, 0 );
+
+            #if defined( __AVR__ )
+                xNumberOfSuccessfulFrees++;
+            #endif
         }
         ( void ) xTaskResumeAll();
     }
 }
+/*-----------------------------------------------------------*/
+
+#if defined( __AVR__ )
+
+    static size_t prvHeapFreeBytes( size_t * pxLargestFreeBlock,
+                                    size_t * pxSmallestFreeBlock,
+                                    size_t * pxNumberOfFreeBlocks )
+    {
+        struct __freelist * pxChunk;
+        char * pcBreak = ( __brkval != NULL ) ? __brkval : __malloc_heap_start;
+        char * pcHeapEnd = __malloc_heap_end;
+        size_t xTotal = 0, xLargest = 0, xSmallest = ( size_t ) -1, xBlocks = 0;
+
+        if( pcHeapEnd == NULL )
+        {
+            /* Without an explicit limit malloc() grows the heap up to __malloc_margin
+             * below the current stack pointer, not up to the end of RAM. */
+            pcHeapEnd = ( char * ) SP - __malloc_margin;
+        }
+
+        /* Memory that has never been handed out counts as one block. */
+        if( pcHeapEnd > pcBreak )
+        {
+            xTotal = ( size_t ) ( pcHeapEnd - pcBreak );
+            xLargest = xTotal;
+            xSmallest = xTotal;
+            xBlocks = 1;
+        }
+
+        for( pxChunk = __flp; pxChunk != NULL; pxChunk = pxChunk->nx )
+        {
+            xTotal += pxChunk->sz;
+            xLargest = ( pxChunk->sz > xLargest ) ? pxChunk->sz : xLargest;
+            xSmallest = ( pxChunk->sz < xSmallest ) ? pxChunk->sz : xSmallest;
+            xBlocks++;
+        }
+
+        if( pxLargestFreeBlock != NULL )
+        {
+            *pxLargestFreeBlock = xLargest;
+        }
+
+        if( pxSmallestFreeBlock != NULL )
+        {
+            *pxSmallestFreeBlock = ( xBlocks > 0 ) ? xSmallest : 0;
+        }
+
+        if( pxNumberOfFreeBlocks != NULL )
+        {
+            *pxNumberOfFreeBlocks = xBlocks;
+        }
+
+        return xTotal;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xPortGetFreeHeapSize( void )
+    {
+        size_t xReturn;
+
+        vTaskSuspendAll();
+        {
+            xReturn = prvHeapFreeBytes( NULL, NULL, NULL );
+        }
+        ( void ) xTaskResumeAll();
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xPortGetMinimumEverFreeHeapSize( void )
+    {
+        size_t xReturn;
+
+        vTaskSuspendAll();
+        {
+            xReturn = prvHeapFreeBytes( NULL, NULL, NULL );
+
+            if( xMinimumEverFreeBytesRemaining < xReturn )
+            {
+                xReturn = xMinimumEverFreeBytesRemaining;
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+    {
+        vTaskSuspendAll();
+        {
+            pxHeapStats->xAvailableHeapSpaceInBytes = prvHeapFreeBytes( &( pxHeapStats->xSizeOfLargestFreeBlockInBytes ),
+                                                                        &( pxHeapStats->xSizeOfSmallestFreeBlockInBytes ),
+                                                                        &( pxHeapStats->xNumberOfFreeBlocks ) );
+            pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+
+            if( pxHeapStats->xAvailableHeapSpaceInBytes < pxHeapStats->xMinimumEverFreeBytesRemaining )
+            {
+                pxHeapStats->xMinimumEverFreeBytesRemaining = pxHeapStats->xAvailableHeapSpaceInBytes;
+            }
+
+            pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+            pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        }
+        ( void ) xTaskResumeAll();
+    }
+
+#endif /* __AVR__ */
+
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_KERNEL_BLOCK_POOLS == 1 )
+
+    void * pvPortBlockPoolAlloc( BlockPool_t * pxPool )
+    {
+        void * pvReturn;
+
+        /* The pool is only ever touched for a few instructions, so a critical
+         * section is cheaper than suspending the scheduler around malloc(). */
+        taskENTER_CRITICAL();
+        {
+            pvReturn = pxPool->pvFreeList;
+
+            if( pvReturn != NULL )
+            {
+                pxPool->pvFreeList = *( ( void ** ) pvReturn );
+            }
+            else if( pxPool->pucNextUnused < pxPool->pucEnd )
+            {
+                pvReturn = pxPool->pucNextUnused;
+                pxPool->pucNextUnused += pxPool->xBlockSize;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        traceMALLOC( pvReturn, pxPool->xBlockSize );
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xPortBlockPoolFree( BlockPool_t * pxPool,
+                                   void * pv )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        if( ( ( uint8_t * ) pv >= pxPool->pucStart ) && ( ( uint8_t * ) pv < pxPool->pucEnd ) )
+        {
+            taskENTER_CRITICAL();
+            {
+                *( ( void ** ) pv ) = pxPool->pvFreeList;
+                pxPool->pvFreeList = pv;
+            }
+            taskEXIT_CRITICAL();
+
+            traceFREE( pv, pxPool->xBlockSize );
+            xReturn = pdTRUE;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_KERNEL_BLOCK_POOLS */
 
 #endif /* ( configSUPPORT_DYNAMIC_ALLOCATION > 0 ) */
@@ -210,6 +210,31 @@ typedef void * MessageBufferHandle_t;
 #define xMessageBufferCreateStatic( xBufferSizeBytes, pucMessageBufferStorageArea, pxStaticMessageBuffer ) \
     ( MessageBufferHandle_t ) xStreamBufferGenericCreateStatic( xBufferSizeBytes, 0, pdTRUE, pucMessageBufferStorageArea, pxStaticMessageBuffer )
 
+/**
+ * message_buffer.h
+ *
+ * <pre>
+ * MessageBufferHandle_t xMessageBufferCreateMultiProducer( size_t xBufferSizeBytes );
+ * MessageBufferHandle_t xMessageBufferCreateMultiProducerStatic( size_t xBufferSizeBytes, uint8_t *pucMessageBufferStorageArea, StaticMessageBuffer_t *pxStaticMessageBuffer );
+ * </pre>
+ *
+ * Creates a message buffer that any number of tasks and interrupts can send
+ * to at the same time without an external mutex, for example a log shared by
+ * several tasks.  Messages are received whole and in the order their space
+ * was reserved.  Sends never block; a message that does not fit is dropped
+ * and the send returns 0.  See xStreamBufferCreateMultiProducer() in
+ * stream_buffer.h.
+ *
+ * \defgroup xMessageBufferCreateMultiProducer xMessageBufferCreateMultiProducer
+ * \ingroup MessageBufferManagement
+ */
+#if ( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+    #define xMessageBufferCreateMultiProducer( xBufferSizeBytes ) \
+    ( MessageBufferHandle_t ) xStreamBufferGenericCreate( xBufferSizeBytes, ( size_t ) 0, sbTYPE_MESSAGE_BUFFER | sbTYPE_MULTI_PRODUCER )
+    #define xMessageBufferCreateMultiProducerStatic( xBufferSizeBytes, pucMessageBufferStorageArea, pxStaticMessageBuffer ) \
+    ( MessageBufferHandle_t ) xStreamBufferGenericCreateStatic( xBufferSizeBytes, 0, sbTYPE_MESSAGE_BUFFER | sbTYPE_MULTI_PRODUCER, pucMessageBufferStorageArea, pxStaticMessageBuffer )
+#endif
+
 /**
  * message_buffer.h
  *
@@ -731,6 +756,42 @@ typedef void * MessageBufferHandle_t;
 #define xMessageBufferNextLengthBytes( xMessageBuffer ) \
     xStreamBufferNextMessageLengthBytes( ( StreamBufferHandle_t ) xMessageBuffer ) PRIVILEGED_FUNCTION;
 
+/**
+ * message_buffer.h
+ * <pre>
+ * size_t xMessageBufferAcquireWrite( MessageBufferHandle_t xMessageBuffer, size_t xMessageLengthBytes, StreamBufferSpans_t *pxSpans, TickType_t xTicksToWait );
+ * void vMessageBufferCommitWrite( MessageBufferHandle_t xMessageBuffer, size_t xBytesWritten );
+ * size_t xMessageBufferAcquireRead( MessageBufferHandle_t xMessageBuffer, StreamBufferSpans_t *pxSpans, TickType_t xTicksToWait );
+ * void vMessageBufferConsumeRead( MessageBufferHandle_t xMessageBuffer, size_t xBytesConsumed );
+ * </pre>
+ *
+ * Build and parse messages in place.  Space is only handed out for a whole
+ * message, and the length written in front of each message is handled by the
+ * buffer, so the spans only ever cover message data.  See
+ * xStreamBufferAcquireWrite() and xStreamBufferAcquireRead() in
+ * stream_buffer.h.
+ *
+ * configUSE_STREAM_BUFFER_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for
+ * these macros to be available.
+ *
+ * \defgroup xMessageBufferAcquireWrite xMessageBufferAcquireWrite
+ * \ingroup MessageBufferManagement
+ */
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+    #define xMessageBufferAcquireWrite( xMessageBuffer, xMessageLengthBytes, pxSpans, xTicksToWait ) \
+    xStreamBufferAcquireWrite( ( StreamBufferHandle_t ) xMessageBuffer, xMessageLengthBytes, pxSpans, xTicksToWait )
+    #define vMessageBufferCommitWrite( xMessageBuffer, xBytesWritten ) \
+    vStreamBufferCommitWrite( ( StreamBufferHandle_t ) xMessageBuffer, xBytesWritten )
+    #define vMessageBufferCommitWriteFromISR( xMessageBuffer, xBytesWritten, pxHigherPriorityTaskWoken ) \
+    vStreamBufferCommitWriteFromISR( ( StreamBufferHandle_t ) xMessageBuffer, xBytesWritten, pxHigherPriorityTaskWoken )
+    #define xMessageBufferAcquireRead( xMessageBuffer, pxSpans, xTicksToWait ) \
+    xStreamBufferAcquireRead( ( StreamBufferHandle_t ) xMessageBuffer, pxSpans, xTicksToWait )
+    #define vMessageBufferConsumeRead( xMessageBuffer, xBytesConsumed ) \
+    vStreamBufferConsumeRead( ( StreamBufferHandle_t ) xMessageBuffer, xBytesConsumed )
+    #define vMessageBufferConsumeReadFromISR( xMessageBuffer, xBytesConsumed, pxHigherPriorityTaskWoken ) \
+    vStreamBufferConsumeReadFromISR( ( StreamBufferHandle_t ) xMessageBuffer, xBytesConsumed, pxHigherPriorityTaskWoken )
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+
 /**
  * message_buffer.h
  *
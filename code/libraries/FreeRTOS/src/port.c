@@ -35,6 +35,10 @@
 #include "Arduino_FreeRTOS.h"
 #include "task.h"
 
+#if ( configUSE_DIRECT_TIMERS == 1 )
+    #include "direct_timer.h"
+#endif
+
 /*-----------------------------------------------------------
  * Implementation of functions defined in portable.h for the AVR port.
  *----------------------------------------------------------*/
@@ -714,3 +718,90 @@ void prvSetupTimerInterrupt( void )
         xTaskIncrementTick();
     }
 #endif
+/*-----------------------------------------------------------*/
+
+/* Without Timer3 direct timers fire on the tick only, and need none of this. */
+#if ( configUSE_DIRECT_TIMERS == 1 ) && ( portHAS_SUB_TICK_TIMER == 1 )
+
+    #if ( portSUB_TICK_PRESCALER == 8 )
+        #define portSUB_TICK_CLOCK_SELECT    ( _BV( CS31 ) )
+    #elif ( portSUB_TICK_PRESCALER == 64 )
+        #define portSUB_TICK_CLOCK_SELECT    ( _BV( CS31 ) | _BV( CS30 ) )
+    #elif ( portSUB_TICK_PRESCALER == 256 )
+        #define portSUB_TICK_CLOCK_SELECT    ( _BV( CS32 ) )
+    #elif ( portSUB_TICK_PRESCALER == 1024 )
+        #define portSUB_TICK_CLOCK_SELECT    ( _BV( CS32 ) | _BV( CS30 ) )
+    #else
+        #error portSUB_TICK_PRESCALER must be 8, 64, 256 or 1024.
+    #endif
+
+    /* Set while Timer3 is counting for a direct timer, together with the
+     * settings it had before, e.g. from the Arduino core for analogWrite(). */
+    static uint8_t ucSubTickTimerArmed = pdFALSE;
+    static uint8_t ucSavedTCCR3A;
+    static uint8_t ucSavedTCCR3B;
+    static uint16_t usSavedOCR3A;
+
+    /*
+     * Timer3 runs in normal mode, counting up from zero at the tick, and only
+     * while a direct timer is waiting for its sub-tick offset.  These are only
+     * called from interrupts, so the 16 bit registers need no extra protection.
+     */
+    void vPortStartSubTickTimer( uint16_t usCompare )
+    {
+        if( ucSubTickTimerArmed == pdFALSE )
+        {
+            ucSavedTCCR3A = TCCR3A;
+            ucSavedTCCR3B = TCCR3B;
+            usSavedOCR3A = OCR3A;
+            ucSubTickTimerArmed = pdTRUE;
+        }
+
+        TCCR3B = 0;
+        TCCR3A = 0;
+        TCNT3 = 0;
+        OCR3A = usCompare;
+        TIFR3 = _BV( OCF3A );
+        TIMSK3 |= _BV( OCIE3A );
+        TCCR3B = portSUB_TICK_CLOCK_SELECT;
+    }
+
+    void vPortSetSubTickCompare( uint16_t usCompare )
+    {
+        OCR3A = usCompare;
+    }
+
+    uint16_t usPortGetSubTickCount( void )
+    {
+        return TCNT3;
+    }
+
+    void vPortStopSubTickTimer( void )
+    {
+        /* Most ticks have no timer waiting for an offset; leave Timer3 alone. */
+        if( ucSubTickTimerArmed != pdFALSE )
+        {
+            TCCR3B = 0;
+            TIMSK3 &= ~_BV( OCIE3A );
+            TCCR3A = ucSavedTCCR3A;
+            OCR3A = usSavedOCR3A;
+            TCCR3B = ucSavedTCCR3B;
+            ucSubTickTimerArmed = pdFALSE;
+        }
+    }
+
+    /*
+     * Sub-tick interrupt.  Unlike the tick this is an ordinary interrupt, so
+     * a context switch is requested with portYIELD(), and the interrupted task
+     * finishes the interrupt when it next runs.
+     */
+    ISR(TIMER3_COMPA_vect) __attribute__ ((hot, flatten));
+    ISR(TIMER3_COMPA_vect)
+    {
+        if( xDirectTimerProcessSubTick() != pdFALSE )
+        {
+            portYIELD();
+        }
+    }
+
+#endif /* configUSE_DIRECT_TIMERS && portHAS_SUB_TICK_TIMER */
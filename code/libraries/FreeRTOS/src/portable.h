@@ -179,6 +179,60 @@ void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_KERNEL_BLOCK_POOLS == 1 )
+
+/*
+ * Fixed-size block pool.  Blocks are handed out from a free list first and
+ * then from the never-used tail of the storage area, so both allocation and
+ * release are O(1) and the pool never fragments.  The storage is supplied by
+ * the caller, normally as a statically allocated array, and each block must
+ * be at least sizeof( void * ) bytes as free blocks are linked through their
+ * first bytes.
+ */
+    typedef struct xBLOCK_POOL
+    {
+        void * pvFreeList;    /* Blocks that have been released back to the pool. */
+        uint8_t * pucNextUnused; /* First block that has never been handed out. */
+        uint8_t * pucStart;   /* First byte of the storage area. */
+        uint8_t * pucEnd;     /* One past the last byte of the storage area. */
+        size_t xBlockSize;    /* Size of each block in bytes. */
+    } BlockPool_t;
+
+/* Statically initialises a BlockPool_t over uxBlockCount blocks of xBlockSize
+ * bytes starting at pvStorage. */
+    #define portBLOCK_POOL_INITIALISER( pvStorage, xBlockSize, uxBlockCount ) \
+    {                                                                        \
+        NULL,                                                                \
+        ( uint8_t * ) ( pvStorage ),                                         \
+        ( uint8_t * ) ( pvStorage ),                                         \
+        ( ( uint8_t * ) ( pvStorage ) ) + ( ( xBlockSize ) * ( uxBlockCount ) ), \
+        ( xBlockSize )                                                       \
+    }
+
+/* Returns a block from the pool, or NULL if the pool is exhausted. */
+    void * pvPortBlockPoolAlloc( BlockPool_t * pxPool ) PRIVILEGED_FUNCTION;
+
+/* Returns pv to the pool.  Returns pdFALSE, and does nothing, if pv was not
+ * allocated from the pool - the caller should then free it to the heap. */
+    BaseType_t xPortBlockPoolFree( BlockPool_t * pxPool,
+                                   void * pv ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_KERNEL_BLOCK_POOLS */
+
+#if ( configUSE_DIRECT_TIMERS == 1 )
+
+/*
+ * Sub-tick timer used by direct_timer.c.  It counts up from 0 from the moment
+ * vPortStartSubTickTimer() is called, which is always from the tick interrupt,
+ * and its compare interrupt calls xDirectTimerProcessSubTick().
+ */
+    void vPortStartSubTickTimer( uint16_t usCompare ) PRIVILEGED_FUNCTION;
+    void vPortSetSubTickCompare( uint16_t usCompare ) PRIVILEGED_FUNCTION;
+    uint16_t usPortGetSubTickCount( void ) PRIVILEGED_FUNCTION;
+    void vPortStopSubTickTimer( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_DIRECT_TIMERS */
+
 /*
  * Setup the hardware ready for the scheduler to take control.  This generally
  * sets up a tick interrupt and sets timers for the correct tick frequency.
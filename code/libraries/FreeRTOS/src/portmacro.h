@@ -92,6 +92,10 @@ typedef uint8_t                     UBaseType_t;
 
 #define portBYTE_ALIGNMENT          1
 #define portNOP()                   __asm__ __volatile__ ( "nop" );
+
+/* Stops the compiler moving memory accesses across the barrier.  The AVR core
+ * does not reorder accesses itself, so nothing more is needed. */
+#define portMEMORY_BARRIER()        __asm__ __volatile__ ( "" ::: "memory" )
 /*-----------------------------------------------------------*/
 
 /* Kernel utilities. */
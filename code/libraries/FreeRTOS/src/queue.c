@@ -132,13 +132,54 @@ typedef struct QueueDef_t
     #if ( configUSE_PRIORITY_CEILING_PROTOCOL == 1 )
         UBaseType_t uxCeilingPriority;
     #endif
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        volatile UBaseType_t uxMessagesReserved; /*< 1 while a slot handed out by pvQueueReserve() has not been committed. */
+        volatile UBaseType_t uxMessagesHeld;     /*< 1 while the item returned by pvQueuePeekInPlace() has not been released. */
+    #endif
+
+    #if ( configUSE_DEADLINE_ORDERED_QUEUES == 1 )
+        uint8_t ucDeadlineOrdered; /*< Set to pdTRUE if the storage area is a binary heap keyed on each item's leading TickType_t, rather than a ring. */
+    #endif
 } Queue_t;
 
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+/* A reserved slot is the next one to be written, so nothing can be queued
+ * until it is committed. */
+    #define queueIS_FULL( pxQueue )    ( ( ( pxQueue )->uxMessagesWaiting == ( pxQueue )->uxLength ) || ( ( pxQueue )->uxMessagesReserved != ( UBaseType_t ) 0U ) )
+
+/* Sending to the front would move the item held by pvQueuePeekInPlace() away
+ * from the front, and overwriting would replace the held item or the reserved
+ * slot, so both wait as on a full queue until the item is released or the slot
+ * committed. */
+    #define queueIS_FULL_FOR_POSITION( pxQueue, xCopyPosition )                                                          \
+    ( ( ( xCopyPosition ) == queueOVERWRITE ) ?                                                                      \
+      ( ( ( pxQueue )->uxMessagesReserved != ( UBaseType_t ) 0U ) || ( ( pxQueue )->uxMessagesHeld != ( UBaseType_t ) 0U ) ) : \
+      ( ( queueIS_FULL( pxQueue ) ) || ( ( ( xCopyPosition ) == queueSEND_TO_FRONT ) && ( ( pxQueue )->uxMessagesHeld != ( UBaseType_t ) 0U ) ) ) )
+#else
+    #define queueIS_FULL( pxQueue )    ( ( pxQueue )->uxMessagesWaiting == ( pxQueue )->uxLength )
+
+/* The head item of a queue of length one can always be overwritten. */
+    #define queueIS_FULL_FOR_POSITION( pxQueue, xCopyPosition )    ( ( ( xCopyPosition ) != queueOVERWRITE ) && ( queueIS_FULL( pxQueue ) ) )
+#endif
+
 #if ( configUSE_PRIORITY_CEILING_PROTOCOL == 1 )
     #define queueMAX_MUTEXES_PCP     ( ( UBaseType_t ) 10 )
     QueueHandle_t xMutexesPCP[queueMAX_MUTEXES_PCP] = { NULL };
 #endif
 
+#if ( configUSE_KERNEL_BLOCK_POOLS == 1 )
+
+/* Each pool block holds a Queue_t followed by up to
+ * configQUEUE_POOL_STORAGE_BYTES of item storage, so semaphores and mutexes
+ * (which store no items) always fit. */
+    #define queuePOOL_BLOCK_SIZE    ( sizeof( Queue_t ) + ( size_t ) configQUEUE_POOL_STORAGE_BYTES )
+
+    PRIVILEGED_DATA static uint8_t ucQueuePoolStorage[ configQUEUE_POOL_LENGTH ][ queuePOOL_BLOCK_SIZE ];
+    PRIVILEGED_DATA static BlockPool_t xQueuePool = portBLOCK_POOL_INITIALISER( ucQueuePoolStorage, queuePOOL_BLOCK_SIZE, configQUEUE_POOL_LENGTH );
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -192,6 +233,12 @@ static BaseType_t prvIsQueueEmpty( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION
  */
 static BaseType_t prvIsQueueFull( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
 
+/*
+ * As prvIsQueueFull(), but for an item sent to xCopyPosition.
+ */
+static BaseType_t prvIsQueueFullForPosition( const Queue_t * pxQueue,
+                                             const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION;
+
 /*
  * Copies an item into the queue, either at the front of the queue or the
  * back of the queue.
@@ -206,6 +253,54 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
 static void prvCopyDataFromQueue( Queue_t * const pxQueue,
                                   void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+/*
+ * Copies uxItemCount consecutive items to the back of a queue, or out of its
+ * front.  The caller checks there is enough space or enough items.
+ */
+static void prvCopyMultipleToQueue( Queue_t * const pxQueue,
+                                    const int8_t * pcItems,
+                                    UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+static void prvCopyMultipleFromQueue( Queue_t * const pxQueue,
+                                      int8_t * pcBuffer,
+                                      UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes up to uxMaxTasks tasks from an event list.  Returns pdTRUE if one of
+ * them has a priority above the running task.
+ */
+static BaseType_t prvWakeWaitingTasks( List_t * const pxEventList,
+                                       UBaseType_t uxMaxTasks ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_DEADLINE_ORDERED_QUEUES == 1 )
+
+/*
+ * Deadline ordered queues keep their uxMessagesWaiting items as a binary heap
+ * in the first slots of the storage area, the most urgent item in slot 0.
+ * These add an item to the heap and remove its root, uxMessagesWaiting being
+ * the count before the change.
+ */
+    static void prvInsertOrderedItem( Queue_t * const pxQueue,
+                                      const void * pvItemToQueue,
+                                      UBaseType_t uxMessagesWaiting ) PRIVILEGED_FUNCTION;
+    static void prvRemoveOrderedItem( Queue_t * const pxQueue,
+                                      UBaseType_t uxMessagesWaiting ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if the key of the item in slot xA is earlier than the key of
+ * the item in slot xB.  Keys are compared allowing for tick count overflow.
+ */
+    static BaseType_t prvIsMoreUrgent( const Queue_t * const pxQueue,
+                                       size_t xA,
+                                       size_t xB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Exchanges the items in two slots of the storage area.
+ */
+    static void prvSwapItems( const Queue_t * const pxQueue,
+                              size_t xA,
+                              size_t xB ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
 /*
@@ -282,6 +377,11 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
         pxQueue->cRxLock = queueUNLOCKED;
         pxQueue->cTxLock = queueUNLOCKED;
 
+        #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+            pxQueue->uxMessagesReserved = ( UBaseType_t ) 0U;
+            pxQueue->uxMessagesHeld = ( UBaseType_t ) 0U;
+        #endif
+
         if( xNewQueue == pdFALSE )
         {
             /* If there are tasks blocked waiting to read from the queue, then
@@ -414,7 +514,26 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
          * are greater than or equal to the pointer to char requirements the cast
          * is safe.  In other cases alignment requirements are not strict (one or
          * two bytes). */
-        pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + xQueueSizeInBytes ); /*lint !e9087 !e9079 see comment above. */
+        #if ( configUSE_KERNEL_BLOCK_POOLS == 1 )
+            {
+                /* Small queues and all semaphores come from the queue pool
+                 * first, so creating them is O(1) and cannot fragment the
+                 * heap. */
+                pxNewQueue = NULL;
+
+                if( xQueueSizeInBytes <= ( size_t ) configQUEUE_POOL_STORAGE_BYTES )
+                {
+                    pxNewQueue = ( Queue_t * ) pvPortBlockPoolAlloc( &xQueuePool );
+                }
+
+                if( pxNewQueue == NULL )
+                {
+                    pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + xQueueSizeInBytes ); /*lint !e9087 !e9079 see comment above. */
+                }
+            }
+        #else
+            pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + xQueueSizeInBytes ); /*lint !e9087 !e9079 see comment above. */
+        #endif /* configUSE_KERNEL_BLOCK_POOLS */
 
         if( pxNewQueue != NULL )
         {
@@ -482,6 +601,12 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
         }
     #endif /* configUSE_TRACE_FACILITY */
 
+    #if ( configUSE_DEADLINE_ORDERED_QUEUES == 1 )
+        {
+            pxNewQueue->ucDeadlineOrdered = pdFALSE;
+        }
+    #endif /* configUSE_DEADLINE_ORDERED_QUEUES */
+
     #if ( configUSE_QUEUE_SETS == 1 )
         {
             pxNewQueue->pxQueueSetContainer = NULL;
@@ -492,6 +617,61 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 }
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_DEADLINE_ORDERED_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateDeadlineOrdered( const UBaseType_t uxQueueLength,
+                                               const UBaseType_t uxItemSize )
+    {
+        Queue_t * pxNewQueue;
+
+        /* Each item starts with its key. */
+        configASSERT( uxItemSize >= ( UBaseType_t ) sizeof( TickType_t ) );
+
+        pxNewQueue = ( Queue_t * ) xQueueGenericCreate( uxQueueLength, uxItemSize, queueQUEUE_TYPE_BASE );
+
+        if( pxNewQueue != NULL )
+        {
+            pxNewQueue->ucDeadlineOrdered = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxNewQueue;
+    }
+
+#endif /* ( ( configUSE_DEADLINE_ORDERED_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_DEADLINE_ORDERED_QUEUES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateDeadlineOrderedStatic( const UBaseType_t uxQueueLength,
+                                                     const UBaseType_t uxItemSize,
+                                                     uint8_t * pucQueueStorage,
+                                                     StaticQueue_t * pxStaticQueue )
+    {
+        Queue_t * pxNewQueue;
+
+        configASSERT( uxItemSize >= ( UBaseType_t ) sizeof( TickType_t ) );
+
+        pxNewQueue = ( Queue_t * ) xQueueGenericCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxStaticQueue, queueQUEUE_TYPE_BASE );
+
+        if( pxNewQueue != NULL )
+        {
+            pxNewQueue->ucDeadlineOrdered = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxNewQueue;
+    }
+
+#endif /* ( ( configUSE_DEADLINE_ORDERED_QUEUES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_MUTEXES == 1 )
 
     static void prvInitialiseMutex( Queue_t * pxNewQueue )
@@ -802,7 +982,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
              * highest priority task wanting to access the queue.  If the head item
              * in the queue is to be overwritten then it does not matter if the
              * queue is full. */
-            if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+            if( queueIS_FULL_FOR_POSITION( pxQueue, xCopyPosition ) == pdFALSE )
             {
                 traceQUEUE_SEND( pxQueue );
 
@@ -943,7 +1123,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
         /* Update the timeout state to see if it has expired yet. */
         if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
         {
-            if( prvIsQueueFull( pxQueue ) != pdFALSE )
+            if( prvIsQueueFullForPosition( pxQueue, xCopyPosition ) != pdFALSE )
             {
                 traceBLOCKING_ON_QUEUE_SEND( pxQueue );
                 vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
@@ -1021,7 +1201,7 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
      * post). */
     uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
     {
-        if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+        if( queueIS_FULL_FOR_POSITION( pxQueue, xCopyPosition ) == pdFALSE )
         {
             const int8_t cTxLock = pxQueue->cTxLock;
             const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
@@ -1335,6 +1515,11 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
      * is zero (so no data is copied into the buffer). */
     configASSERT( !( ( ( pvBuffer ) == NULL ) && ( ( pxQueue )->uxItemSize != ( UBaseType_t ) 0U ) ) );
 
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        /* The front item must not be removed while it is read in place. */
+        configASSERT( pxQueue->uxMessagesHeld == ( UBaseType_t ) 0U );
+    #endif
+
     /* Cannot block if the scheduler is suspended. */
     #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
         {
@@ -1357,6 +1542,11 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
             {
                 /* Data available, remove one item. */
                 prvCopyDataFromQueue( pxQueue, pvBuffer );
+
+                #if ( configUSE_DEADLINE_ORDERED_QUEUES == 1 )
+                    prvRemoveOrderedItem( pxQueue, uxMessagesWaiting );
+                #endif
+
                 traceQUEUE_RECEIVE( pxQueue );
                 pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
 
@@ -2071,6 +2261,10 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
     configASSERT( pxQueue );
     configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
 
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        configASSERT( pxQueue->uxMessagesHeld == ( UBaseType_t ) 0U );
+    #endif
+
     /* RTOS ports that support interrupt nesting have the concept of a maximum
      * system call (or maximum API call) interrupt priority.  Interrupts that are
      * above the maximum system call priority are kept permanently enabled, even
@@ -2099,6 +2293,11 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
             traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
 
             prvCopyDataFromQueue( pxQueue, pvBuffer );
+
+            #if ( configUSE_DEADLINE_ORDERED_QUEUES == 1 )
+                prvRemoveOrderedItem( pxQueue, uxMessagesWaiting );
+            #endif
+
             pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
 
             /* If the queue is locked the event list will not be modified.
@@ -2210,123 +2409,822 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
 }
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-
-    configASSERT( xQueue );
-
-    taskENTER_CRITICAL();
-    {
-        uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
-    }
-    taskEXIT_CRITICAL();
-
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
-
-UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+UBaseType_t uxQueueSendMultiple( QueueHandle_t xQueue,
+                                 const void * pvItems,
+                                 UBaseType_t uxItemCount,
+                                 TickType_t xTicksToWait )
 {
-    UBaseType_t uxReturn;
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    UBaseType_t uxSent = 0, uxBatch;
     Queue_t * const pxQueue = xQueue;
 
     configASSERT( pxQueue );
+    configASSERT( pvItems != NULL );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U ); /* Semaphores hold no data. */
 
-    taskENTER_CRITICAL();
-    {
-        uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
-    }
-    taskEXIT_CRITICAL();
+    #if ( configUSE_DEADLINE_ORDERED_QUEUES == 1 )
+        configASSERT( pxQueue->ucDeadlineOrdered == pdFALSE ); /* Items are not stored in ring order. */
+    #endif
 
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
+    #if ( configUSE_QUEUE_SETS == 1 )
+        configASSERT( pxQueue->pxQueueSetContainer == NULL );
+    #endif
 
-UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
-{
-    UBaseType_t uxReturn;
-    Queue_t * const pxQueue = xQueue;
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+    #endif
 
-    configASSERT( pxQueue );
-    uxReturn = pxQueue->uxMessagesWaiting;
+    /*lint -save -e904 This function relaxes the coding standard somewhat to
+     * allow return statements within the function itself. */
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
+        {
+            if( queueIS_FULL( pxQueue ) == pdFALSE )
+            {
+                /* Move as many items as fit in one go and wake no more tasks than
+                 * there are new items. */
+                uxBatch = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
 
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
+                if( uxBatch > ( uxItemCount - uxSent ) )
+                {
+                    uxBatch = uxItemCount - uxSent;
+                }
 
-void vQueueDelete( QueueHandle_t xQueue )
-{
-    Queue_t * const pxQueue = xQueue;
+                prvCopyMultipleToQueue( pxQueue, ( const int8_t * ) pvItems + ( uxSent * pxQueue->uxItemSize ), uxBatch );
+                uxSent += uxBatch;
+                traceQUEUE_SEND( pxQueue );
 
-    configASSERT( pxQueue );
-    traceQUEUE_DELETE( pxQueue );
+                if( prvWakeWaitingTasks( &( pxQueue->xTasksWaitingToReceive ), uxBatch ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-    #if ( configQUEUE_REGISTRY_SIZE > 0 )
-        {
-            vQueueUnregisterQueue( pxQueue );
-        }
-    #endif
+                if( uxSent == uxItemCount )
+                {
+                    taskEXIT_CRITICAL();
+                    return uxSent;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
 
-    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
-        {
-            /* The queue can only have been allocated dynamically - free it
-             * again. */
-            vPortFree( pxQueue );
+            if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                taskEXIT_CRITICAL();
+                traceQUEUE_SEND_FAILED( pxQueue );
+                return uxSent;
+            }
+            else if( xEntryTimeSet == pdFALSE )
+            {
+                vTaskInternalSetTimeOutState( &xTimeOut );
+                xEntryTimeSet = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
-    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+        taskEXIT_CRITICAL();
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
         {
-            /* The queue could have been allocated statically or dynamically, so
-             * check before attempting to free the memory. */
-            if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+            if( prvIsQueueFull( pxQueue ) != pdFALSE )
             {
-                vPortFree( pxQueue );
+                traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    portYIELD_WITHIN_API();
+                }
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
             }
         }
-    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
+        else
         {
-            /* The queue must have been statically allocated, so is not going to be
-             * deleted.  Avoid compiler warnings about the unused parameter. */
-            ( void ) pxQueue;
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            traceQUEUE_SEND_FAILED( pxQueue );
+            return uxSent;
         }
-    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+    } /*lint -restore */
 }
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+UBaseType_t uxQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                        const void * pvItems,
+                                        UBaseType_t uxItemCount,
+                                        BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    UBaseType_t uxSavedInterruptStatus, uxBatch = 0;
+    Queue_t * const pxQueue = xQueue;
 
-    UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
-    {
-        return ( ( Queue_t * ) xQueue )->uxQueueNumber;
-    }
+    configASSERT( pxQueue );
+    configASSERT( pvItems != NULL );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
+    #if ( configUSE_DEADLINE_ORDERED_QUEUES == 1 )
+        configASSERT( pxQueue->ucDeadlineOrdered == pdFALSE ); /* Items are not stored in ring order. */
+    #endif
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+    #if ( configUSE_QUEUE_SETS == 1 )
+        configASSERT( pxQueue->pxQueueSetContainer == NULL );
+    #endif
 
-    void vQueueSetQueueNumber( QueueHandle_t xQueue,
-                               UBaseType_t uxQueueNumber )
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
     {
-        ( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
-    }
+        if( queueIS_FULL( pxQueue ) == pdFALSE )
+        {
+            const int8_t cTxLock = pxQueue->cTxLock;
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
+            uxBatch = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+            if( uxBatch > uxItemCount )
+            {
+                uxBatch = uxItemCount;
+            }
 
-    uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
-    {
-        return ( ( Queue_t * ) xQueue )->ucQueueType;
-    }
+            traceQUEUE_SEND_FROM_ISR( pxQueue );
+            prvCopyMultipleToQueue( pxQueue, ( const int8_t * ) pvItems, uxBatch );
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
+            /* The event list is not altered if the queue is locked.  The tasks
+             * that can be woken are counted instead and woken on unlock. */
+            if( cTxLock == queueUNLOCKED )
+            {
+                if( ( prvWakeWaitingTasks( &( pxQueue->xTasksWaitingToReceive ), uxBatch ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+                {
+                    *pxHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                UBaseType_t uxWaiting = listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) );
+                pxQueue->cTxLock = ( int8_t ) ( cTxLock + ( int8_t ) ( ( uxWaiting < uxBatch ) ? uxWaiting : uxBatch ) );
+            }
+        }
+        else
+        {
+            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+        }
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+    return uxBatch;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueReceiveMultiple( QueueHandle_t xQueue,
+                                    void * pvBuffer,
+                                    UBaseType_t uxMaxItems,
+                                    TickType_t xTicksToWait )
+{
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    UBaseType_t uxBatch;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    configASSERT( pvBuffer != NULL );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U ); /* Semaphores hold no data. */
+
+    #if ( configUSE_DEADLINE_ORDERED_QUEUES == 1 )
+        configASSERT( pxQueue->ucDeadlineOrdered == pdFALSE ); /* Items are not stored in ring order. */
+    #endif
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        configASSERT( pxQueue->uxMessagesHeld == ( UBaseType_t ) 0U );
+    #endif
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+    #endif
+
+    /*lint -save -e904 This function relaxes the coding standard somewhat to
+     * allow return statements within the function itself. */
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
+        {
+            uxBatch = pxQueue->uxMessagesWaiting;
+
+            if( uxBatch > ( UBaseType_t ) 0 )
+            {
+                if( uxBatch > uxMaxItems )
+                {
+                    uxBatch = uxMaxItems;
+                }
+
+                prvCopyMultipleFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxBatch );
+                traceQUEUE_RECEIVE( pxQueue );
+
+                if( prvWakeWaitingTasks( &( pxQueue->xTasksWaitingToSend ), uxBatch ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                taskEXIT_CRITICAL();
+                return uxBatch;
+            }
+            else
+            {
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    taskEXIT_CRITICAL();
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    return 0;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    portYIELD_WITHIN_API();
+                }
+            }
+            else
+            {
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceQUEUE_RECEIVE_FAILED( pxQueue );
+                return 0;
+            }
+        }
+    } /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                           void * pvBuffer,
+                                           UBaseType_t uxMaxItems,
+                                           BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    UBaseType_t uxSavedInterruptStatus, uxBatch;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    configASSERT( pvBuffer != NULL );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+    #if ( configUSE_DEADLINE_ORDERED_QUEUES == 1 )
+        configASSERT( pxQueue->ucDeadlineOrdered == pdFALSE ); /* Items are not stored in ring order. */
+    #endif
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        configASSERT( pxQueue->uxMessagesHeld == ( UBaseType_t ) 0U );
+    #endif
+
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        uxBatch = pxQueue->uxMessagesWaiting;
+
+        if( uxBatch > ( UBaseType_t ) 0 )
+        {
+            const int8_t cRxLock = pxQueue->cRxLock;
+
+            if( uxBatch > uxMaxItems )
+            {
+                uxBatch = uxMaxItems;
+            }
+
+            traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+            prvCopyMultipleFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxBatch );
+
+            if( cRxLock == queueUNLOCKED )
+            {
+                if( ( prvWakeWaitingTasks( &( pxQueue->xTasksWaitingToSend ), uxBatch ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+                {
+                    *pxHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                UBaseType_t uxWaiting = listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToSend ) );
+                pxQueue->cRxLock = ( int8_t ) ( cRxLock + ( int8_t ) ( ( uxWaiting < uxBatch ) ? uxWaiting : uxBatch ) );
+            }
+        }
+        else
+        {
+            traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+        }
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+    return uxBatch;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    void * pvQueueReserve( QueueHandle_t xQueue,
+                           TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U ); /* Semaphores hold no data. */
+
+        #if ( configUSE_DEADLINE_ORDERED_QUEUES == 1 )
+            configASSERT( pxQueue->ucDeadlineOrdered == pdFALSE ); /* Items are not stored in ring order. */
+        #endif
+
+        #if ( configUSE_QUEUE_SETS == 1 )
+            configASSERT( pxQueue->pxQueueSetContainer == NULL );
+        #endif
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+            {
+                configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+            }
+        #endif
+
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself. */
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( queueIS_FULL( pxQueue ) == pdFALSE )
+                {
+                    /* The slot at pcWriteTo is handed out.  pcWriteTo only moves on
+                     * when the item is committed, and the queue reads as full until
+                     * then so nothing can be queued behind an unfinished item. */
+                    pxQueue->uxMessagesReserved = ( UBaseType_t ) 1U;
+                    taskEXIT_CRITICAL();
+                    return ( void * ) pxQueue->pcWriteTo;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        taskEXIT_CRITICAL();
+                        traceQUEUE_SEND_FAILED( pxQueue );
+                        return NULL;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueFull( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                }
+                else
+                {
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                traceQUEUE_SEND_FAILED( pxQueue );
+                return NULL;
+            }
+        } /*lint -restore */
+    }
+/*-----------------------------------------------------------*/
+
+    void vQueueCommit( QueueHandle_t xQueue )
+    {
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+
+        taskENTER_CRITICAL();
+        {
+            configASSERT( pxQueue->uxMessagesReserved != ( UBaseType_t ) 0U );
+
+            pxQueue->uxMessagesReserved = ( UBaseType_t ) 0U;
+            pxQueue->pcWriteTo += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok. */
+
+            if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+            {
+                pxQueue->pcWriteTo = pxQueue->pcHead;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxQueue->uxMessagesWaiting++;
+            traceQUEUE_SEND( pxQueue );
+
+            if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+            {
+                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* A sender that found the queue reserved may be able to proceed now,
+             * including one overwriting the item just committed. */
+            if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+            {
+                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvQueuePeekInPlace( QueueHandle_t xQueue,
+                               TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
+        int8_t * pcItem;
+
+        configASSERT( pxQueue );
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U ); /* Semaphores hold no data. */
+
+        #if ( configUSE_DEADLINE_ORDERED_QUEUES == 1 )
+            configASSERT( pxQueue->ucDeadlineOrdered == pdFALSE ); /* Items are not stored in ring order. */
+        #endif
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+            {
+                configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+            }
+        #endif
+
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself. */
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* Only one item can be held at a time. */
+                configASSERT( pxQueue->uxMessagesHeld == ( UBaseType_t ) 0U );
+
+                if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+                {
+                    /* The item stays counted in uxMessagesWaiting, so its slot cannot
+                     * be written until it is released. */
+                    pcItem = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok. */
+
+                    if( pcItem >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+                    {
+                        pcItem = pxQueue->pcHead;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    pxQueue->uxMessagesHeld = ( UBaseType_t ) 1U;
+                    traceQUEUE_PEEK( pxQueue );
+                    taskEXIT_CRITICAL();
+                    return ( void * ) pcItem;
+                }
+                else
+                {
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        taskEXIT_CRITICAL();
+                        traceQUEUE_PEEK_FAILED( pxQueue );
+                        return NULL;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_PEEK( pxQueue );
+                    vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                }
+                else
+                {
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceQUEUE_PEEK_FAILED( pxQueue );
+                    return NULL;
+                }
+            }
+        } /*lint -restore */
+    }
+/*-----------------------------------------------------------*/
+
+    void vQueueReleasePeeked( QueueHandle_t xQueue )
+    {
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+
+        taskENTER_CRITICAL();
+        {
+            configASSERT( pxQueue->uxMessagesHeld != ( UBaseType_t ) 0U );
+
+            pxQueue->uxMessagesHeld = ( UBaseType_t ) 0U;
+            pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok. */
+
+            if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+            {
+                pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxQueue->uxMessagesWaiting--;
+            traceQUEUE_RECEIVE( pxQueue );
+
+            if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+            {
+                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+
+    configASSERT( xQueue );
+
+    taskENTER_CRITICAL();
+    {
+        uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+    }
+    taskEXIT_CRITICAL();
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+
+    taskENTER_CRITICAL();
+    {
+        uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+
+        #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+            uxReturn -= pxQueue->uxMessagesReserved;
+        #endif
+    }
+    taskEXIT_CRITICAL();
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
+{
+    UBaseType_t uxReturn;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    uxReturn = pxQueue->uxMessagesWaiting;
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+void vQueueDelete( QueueHandle_t xQueue )
+{
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    traceQUEUE_DELETE( pxQueue );
+
+    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+        {
+            vQueueUnregisterQueue( pxQueue );
+        }
+    #endif
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+        {
+            /* The queue can only have been allocated dynamically - free it
+             * again. */
+            #if ( configUSE_KERNEL_BLOCK_POOLS == 1 )
+                if( xPortBlockPoolFree( &xQueuePool, pxQueue ) == pdFALSE )
+            #endif
+            {
+                vPortFree( pxQueue );
+            }
+        }
+    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+        {
+            /* The queue could have been allocated statically or dynamically, so
+             * check before attempting to free the memory. */
+            if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+            {
+                #if ( configUSE_KERNEL_BLOCK_POOLS == 1 )
+                    if( xPortBlockPoolFree( &xQueuePool, pxQueue ) == pdFALSE )
+                #endif
+                {
+                    vPortFree( pxQueue );
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
+        {
+            /* The queue must have been statically allocated, so is not going to be
+             * deleted.  Avoid compiler warnings about the unused parameter. */
+            ( void ) pxQueue;
+        }
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
+    {
+        return ( ( Queue_t * ) xQueue )->uxQueueNumber;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    void vQueueSetQueueNumber( QueueHandle_t xQueue,
+                               UBaseType_t uxQueueNumber )
+    {
+        ( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
+    {
+        return ( ( Queue_t * ) xQueue )->ucQueueType;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
 
 #if ( configUSE_MUTEXES == 1 )
 
@@ -2383,6 +3281,25 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
             }
         #endif /* configUSE_MUTEXES */
     }
+
+    #if ( configUSE_DEADLINE_ORDERED_QUEUES == 1 )
+        else if( pxQueue->ucDeadlineOrdered != pdFALSE )
+        {
+            /* The key decides where the item goes, not xPosition.  An
+             * overwrite can only be used on a queue of length one, so it
+             * replaces the only item. */
+            if( ( xPosition == queueOVERWRITE ) && ( uxMessagesWaiting > ( UBaseType_t ) 0 ) )
+            {
+                --uxMessagesWaiting;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            prvInsertOrderedItem( pxQueue, pvItemToQueue, uxMessagesWaiting );
+        }
+    #endif /* configUSE_DEADLINE_ORDERED_QUEUES */
     else if( xPosition == queueSEND_TO_BACK )
     {
         ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
@@ -2441,6 +3358,17 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
 static void prvCopyDataFromQueue( Queue_t * const pxQueue,
                                   void * const pvBuffer )
 {
+    #if ( configUSE_DEADLINE_ORDERED_QUEUES == 1 )
+        if( pxQueue->ucDeadlineOrdered != pdFALSE )
+        {
+            /* The most urgent item is always the root of the heap.  Receiving
+             * functions then call prvRemoveOrderedItem(); peeking ones leave
+             * the heap as it is. */
+            ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->pcHead, ( size_t ) pxQueue->uxItemSize );
+            return;
+        }
+    #endif /* configUSE_DEADLINE_ORDERED_QUEUES */
+
     if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
     {
         pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;           /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
@@ -2459,6 +3387,228 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
 }
 /*-----------------------------------------------------------*/
 
+static void prvCopyMultipleToQueue( Queue_t * const pxQueue,
+                                    const int8_t * pcItems,
+                                    UBaseType_t uxItemCount )
+{
+    size_t xBytes = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+    size_t xFirst = ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo );
+
+    /* This function is called from a critical section.  The items are copied
+     * in at most two runs, up to the end of the storage area and from its
+     * start. */
+    if( xFirst > xBytes )
+    {
+        xFirst = xBytes;
+    }
+
+    ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItems, xFirst );
+    ( void ) memcpy( ( void * ) pxQueue->pcHead, ( const void * ) ( pcItems + xFirst ), xBytes - xFirst );
+
+    if( xFirst == xBytes )
+    {
+        pxQueue->pcWriteTo += xBytes; /*lint !e9016 Pointer arithmetic on char types ok. */
+    }
+    else
+    {
+        pxQueue->pcWriteTo = pxQueue->pcHead + ( xBytes - xFirst );
+    }
+
+    if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+    {
+        pxQueue->pcWriteTo = pxQueue->pcHead;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxQueue->uxMessagesWaiting += uxItemCount;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyMultipleFromQueue( Queue_t * const pxQueue,
+                                      int8_t * pcBuffer,
+                                      UBaseType_t uxItemCount )
+{
+    size_t xBytes = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+    int8_t * pcFirstItem = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok. */
+    size_t xFirst;
+
+    if( pcFirstItem >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+    {
+        pcFirstItem = pxQueue->pcHead;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    xFirst = ( size_t ) ( pxQueue->u.xQueue.pcTail - pcFirstItem );
+
+    if( xFirst > xBytes )
+    {
+        xFirst = xBytes;
+    }
+
+    ( void ) memcpy( ( void * ) pcBuffer, ( const void * ) pcFirstItem, xFirst );
+    ( void ) memcpy( ( void * ) ( pcBuffer + xFirst ), ( const void * ) pxQueue->pcHead, xBytes - xFirst );
+
+    /* pcReadFrom points to the last item read. */
+    if( xFirst == xBytes )
+    {
+        pxQueue->u.xQueue.pcReadFrom = pcFirstItem + xBytes - pxQueue->uxItemSize;
+    }
+    else
+    {
+        pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead + ( xBytes - xFirst ) - pxQueue->uxItemSize;
+    }
+
+    pxQueue->uxMessagesWaiting -= uxItemCount;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWakeWaitingTasks( List_t * const pxEventList,
+                                       UBaseType_t uxMaxTasks )
+{
+    BaseType_t xYieldRequired = pdFALSE;
+
+    /* One task per item at most, and never more than are waiting. */
+    while( ( uxMaxTasks > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( pxEventList ) == pdFALSE ) )
+    {
+        if( xTaskRemoveFromEventList( pxEventList ) != pdFALSE )
+        {
+            xYieldRequired = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        uxMaxTasks--;
+    }
+
+    return xYieldRequired;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DEADLINE_ORDERED_QUEUES == 1 )
+
+    static BaseType_t prvIsMoreUrgent( const Queue_t * const pxQueue,
+                                       size_t xA,
+                                       size_t xB )
+    {
+        TickType_t xKeyA, xKeyB;
+
+        /* Items need not be aligned, so copy the keys out. */
+        ( void ) memcpy( ( void * ) &xKeyA, ( void * ) ( pxQueue->pcHead + ( xA * pxQueue->uxItemSize ) ), sizeof( TickType_t ) );
+        ( void ) memcpy( ( void * ) &xKeyB, ( void * ) ( pxQueue->pcHead + ( xB * pxQueue->uxItemSize ) ), sizeof( TickType_t ) );
+
+        /* A is earlier if B lies less than half the tick range after it. */
+        if( ( xKeyA != xKeyB ) && ( ( TickType_t ) ( xKeyB - xKeyA ) <= ( portMAX_DELAY >> 1 ) ) )
+        {
+            return pdTRUE;
+        }
+
+        return pdFALSE;
+    }
+    /*-----------------------------------------------------------*/
+
+    static void prvSwapItems( const Queue_t * const pxQueue,
+                              size_t xA,
+                              size_t xB )
+    {
+        int8_t * pcA = pxQueue->pcHead + ( xA * pxQueue->uxItemSize );
+        int8_t * pcB = pxQueue->pcHead + ( xB * pxQueue->uxItemSize );
+        UBaseType_t uxByte;
+        int8_t cTemp;
+
+        /* Swapped a byte at a time so no item sized buffer is needed. */
+        for( uxByte = 0; uxByte < pxQueue->uxItemSize; uxByte++ )
+        {
+            cTemp = pcA[ uxByte ];
+            pcA[ uxByte ] = pcB[ uxByte ];
+            pcB[ uxByte ] = cTemp;
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+    static void prvInsertOrderedItem( Queue_t * const pxQueue,
+                                      const void * pvItemToQueue,
+                                      UBaseType_t uxMessagesWaiting )
+    {
+        size_t xChild = ( size_t ) uxMessagesWaiting, xParent;
+
+        /* This function is called from a critical section.  Add the item as
+         * the last leaf, then move it up past every parent it is more urgent
+         * than. */
+        ( void ) memcpy( ( void * ) ( pxQueue->pcHead + ( xChild * pxQueue->uxItemSize ) ), pvItemToQueue, ( size_t ) pxQueue->uxItemSize );
+
+        while( xChild > ( size_t ) 0 )
+        {
+            xParent = ( xChild - ( size_t ) 1 ) >> 1;
+
+            if( prvIsMoreUrgent( pxQueue, xChild, xParent ) == pdFALSE )
+            {
+                break;
+            }
+
+            prvSwapItems( pxQueue, xChild, xParent );
+            xChild = xParent;
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+    static void prvRemoveOrderedItem( Queue_t * const pxQueue,
+                                      UBaseType_t uxMessagesWaiting )
+    {
+        size_t xCount, xParent = 0, xChild;
+
+        if( pxQueue->ucDeadlineOrdered == pdFALSE )
+        {
+            return;
+        }
+
+        /* This function is called from a critical section, after the root has
+         * been copied out.  Move the last leaf to the root, then down past
+         * every child more urgent than it. */
+        configASSERT( uxMessagesWaiting > ( UBaseType_t ) 0 );
+        xCount = ( size_t ) uxMessagesWaiting - ( size_t ) 1;
+
+        if( xCount == ( size_t ) 0 )
+        {
+            return;
+        }
+
+        ( void ) memcpy( ( void * ) pxQueue->pcHead, ( void * ) ( pxQueue->pcHead + ( xCount * pxQueue->uxItemSize ) ), ( size_t ) pxQueue->uxItemSize );
+
+        for( ; ; )
+        {
+            xChild = ( xParent << 1 ) + ( size_t ) 1;
+
+            if( xChild >= xCount )
+            {
+                break;
+            }
+
+            if( ( ( xChild + ( size_t ) 1 ) < xCount ) && ( prvIsMoreUrgent( pxQueue, xChild + ( size_t ) 1, xChild ) != pdFALSE ) )
+            {
+                xChild++;
+            }
+
+            if( prvIsMoreUrgent( pxQueue, xChild, xParent ) == pdFALSE )
+            {
+                break;
+            }
+
+            prvSwapItems( pxQueue, xChild, xParent );
+            xParent = xChild;
+        }
+    }
+
+#endif /* configUSE_DEADLINE_ORDERED_QUEUES */
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue( Queue_t * const pxQueue )
 {
     /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
@@ -2626,7 +3776,29 @@ static BaseType_t prvIsQueueFull( const Queue_t * pxQueue )
 
     taskENTER_CRITICAL();
     {
-        if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+        if( queueIS_FULL( pxQueue ) != pdFALSE )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvIsQueueFullForPosition( const Queue_t * pxQueue,
+                                             const BaseType_t xCopyPosition )
+{
+    BaseType_t xReturn;
+
+    taskENTER_CRITICAL();
+    {
+        if( queueIS_FULL_FOR_POSITION( pxQueue, xCopyPosition ) != pdFALSE )
         {
             xReturn = pdTRUE;
         }
@@ -2648,7 +3820,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
     configASSERT( pxQueue );
 
-    if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+    if( queueIS_FULL( pxQueue ) != pdFALSE )
     {
         xReturn = pdTRUE;
     }
@@ -3257,10 +4429,21 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
         /* Check the queue pointer is not NULL. */
         configASSERT( ( pxQueue ) );
 
+        pxQueue->uxCeilingPriority = uxCeilingPriority;
+
+        /* A mutex that is already in the resource list only gets its new ceiling, so
+         * ceilings can be initialized again when task priorities change. */
+        for ( UBaseType_t uxEntry = 0; uxEntry < uxIndex; uxEntry++ )
+        {
+            if ( xMutexesPCP[uxEntry] == xQueue )
+            {
+                return;
+            }
+        }
+
         /* Check if the size of the resource list does not cross the allotted size. */
         configASSERT( uxIndex < queueMAX_MUTEXES_PCP );
-    
-        pxQueue->uxCeilingPriority = uxCeilingPriority;
+
         xMutexesPCP[uxIndex++] = xQueue;
     }
 
@@ -233,6 +233,82 @@ typedef struct QueueDef_t * QueueSetMemberHandle_t;
     #define xQueueCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxQueueBuffer )    xQueueGenericCreateStatic( ( uxQueueLength ), ( uxItemSize ), ( pucQueueStorage ), ( pxQueueBuffer ), ( queueQUEUE_TYPE_BASE ) )
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * queue. h
+ * <pre>
+ * QueueHandle_t xQueueCreateDeadlineOrdered(
+ *                            UBaseType_t uxQueueLength,
+ *                            UBaseType_t uxItemSize
+ *                        );
+ * </pre>
+ *
+ * Creates a queue that is received from in order of urgency rather than in
+ * order of arrival.  Each item must start with a TickType_t key, normally the
+ * absolute deadline of the request it carries; the item with the earliest key
+ * is always received first, keys being compared allowing for the tick count
+ * wrapping.  Items with equal keys are not guaranteed to be received in
+ * arrival order.
+ *
+ * The items are kept as a binary heap in the queue's own storage area, so
+ * sending and receiving take time proportional to log2 of the number of items
+ * queued.  The queue is otherwise used with the normal API; the position
+ * given to xQueueGenericSend() is ignored.  It cannot be used with the
+ * zero-copy or batched functions.
+ *
+ * configUSE_DEADLINE_ORDERED_QUEUES must be set to 1 in FreeRTOSConfig.h for
+ * this function to be available.
+ *
+ * @param uxQueueLength The maximum number of items the queue can hold.
+ *
+ * @param uxItemSize The size of each item, at least sizeof( TickType_t ).
+ *
+ * @return The handle of the queue, or NULL if it could not be created.
+ *
+ * Example usage:
+ * <pre>
+ * struct ARequest
+ * {
+ *  TickType_t xDeadline;
+ *  uint8_t ucCommand;
+ * } xRequest;
+ *
+ * xQueue = xQueueCreateDeadlineOrdered( 8, sizeof( struct ARequest ) );
+ *
+ * xRequest.xDeadline = xTaskGetTickCount() + pdMS_TO_TICKS( 50 );
+ * xQueueSend( xQueue, &xRequest, portMAX_DELAY );
+ * </pre>
+ * \defgroup xQueueCreateDeadlineOrdered xQueueCreateDeadlineOrdered
+ * \ingroup QueueManagement
+ */
+#if ( ( configUSE_DEADLINE_ORDERED_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+    QueueHandle_t xQueueCreateDeadlineOrdered( const UBaseType_t uxQueueLength,
+                                               const UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * <pre>
+ * QueueHandle_t xQueueCreateDeadlineOrderedStatic(
+ *                            UBaseType_t uxQueueLength,
+ *                            UBaseType_t uxItemSize,
+ *                            uint8_t *pucQueueStorage,
+ *                            StaticQueue_t *pxQueueBuffer
+ *                        );
+ * </pre>
+ *
+ * As xQueueCreateDeadlineOrdered(), but using the caller's storage area and
+ * queue structure, as xQueueCreateStatic() does.
+ *
+ * \defgroup xQueueCreateDeadlineOrderedStatic xQueueCreateDeadlineOrderedStatic
+ * \ingroup QueueManagement
+ */
+#if ( ( configUSE_DEADLINE_ORDERED_QUEUES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    QueueHandle_t xQueueCreateDeadlineOrderedStatic( const UBaseType_t uxQueueLength,
+                                                     const UBaseType_t uxItemSize,
+                                                     uint8_t * pucQueueStorage,
+                                                     StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * queue. h
  * <pre>
@@ -1695,9 +1771,215 @@ QueueSetMemberHandle_t xQueueSelectFromSet( QueueSetHandle_t xQueueSet,
  */
 QueueSetMemberHandle_t xQueueSelectFromSetFromISR( QueueSetHandle_t xQueueSet ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * <pre>
+ * UBaseType_t uxQueueSendMultiple( QueueHandle_t xQueue, const void *pvItems, UBaseType_t uxItemCount, TickType_t xTicksToWait );
+ * </pre>
+ *
+ * Post uxItemCount items, stored consecutively at pvItems, to the back of a
+ * queue.  As many items as fit are copied under a single critical section,
+ * so a burst of items costs one entry to the kernel rather than one per item.
+ * If the queue fills the task blocks for space as xQueueSend() would, for no
+ * longer than xTicksToWait in total.  Cannot be used on semaphores or queue
+ * set members.
+ *
+ * Each batch copied unblocks one waiting receiver per item, up to the number
+ * of receivers waiting, and yields at most once.  This is not one wake-up per
+ * batch: waking a single receiver would leave the other items queued while
+ * the other receivers stay blocked until they time out.  A queue with one
+ * receiver, the usual case, sees one wake-up per batch.
+ *
+ * @param xQueue The handle to the queue.
+ *
+ * @param pvItems A pointer to the first of the items to be queued.
+ *
+ * @param uxItemCount The number of items at pvItems.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space.
+ *
+ * @return The number of items queued, uxItemCount unless the timeout expired.
+ *
+ * Example usage:
+ * <pre>
+ * uint16_t usSamples[ 8 ];
+ * uxQueueSendMultiple( xQueue, usSamples, 8, portMAX_DELAY );
+ * </pre>
+ * \defgroup uxQueueSendMultiple uxQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueSendMultiple( QueueHandle_t xQueue,
+                                 const void * pvItems,
+                                 UBaseType_t uxItemCount,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ * UBaseType_t uxQueueSendMultipleFromISR( QueueHandle_t xQueue, const void *pvItems, UBaseType_t uxItemCount, BaseType_t *pxHigherPriorityTaskWoken );
+ * </pre>
+ *
+ * A version of uxQueueSendMultiple() that can be called from an ISR.  Copies
+ * as many of the items as there is space for and never blocks.  Waiting
+ * receivers are unblocked as by uxQueueSendMultiple().
+ *
+ * @return The number of items queued.
+ *
+ * \defgroup uxQueueSendMultipleFromISR uxQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                        const void * pvItems,
+                                        UBaseType_t uxItemCount,
+                                        BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ * UBaseType_t uxQueueReceiveMultiple( QueueHandle_t xQueue, void *pvBuffer, UBaseType_t uxMaxItems, TickType_t xTicksToWait );
+ * </pre>
+ *
+ * Receive up to uxMaxItems items from the front of a queue under a single
+ * critical section.  The task blocks only while the queue is empty, then
+ * takes whatever is available up to uxMaxItems.  One task waiting to send is
+ * unblocked per item removed, up to the number of senders waiting, so every
+ * sender that now has space runs; with a single sender that is one wake-up
+ * per batch.
+ *
+ * @param xQueue The handle to the queue.
+ *
+ * @param pvBuffer Buffer with room for uxMaxItems items.
+ *
+ * @param uxMaxItems The maximum number of items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for the first item.
+ *
+ * @return The number of items received, 0 if the timeout expired.
+ *
+ * \defgroup uxQueueReceiveMultiple uxQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueReceiveMultiple( QueueHandle_t xQueue,
+                                    void * pvBuffer,
+                                    UBaseType_t uxMaxItems,
+                                    TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ * UBaseType_t uxQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void *pvBuffer, UBaseType_t uxMaxItems, BaseType_t *pxHigherPriorityTaskWoken );
+ * </pre>
+ *
+ * A version of uxQueueReceiveMultiple() that can be called from an ISR.
+ * Waiting senders are unblocked as by uxQueueReceiveMultiple().
+ *
+ * @return The number of items received.
+ *
+ * \defgroup uxQueueReceiveMultipleFromISR uxQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+UBaseType_t uxQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                           void * pvBuffer,
+                                           UBaseType_t uxMaxItems,
+                                           BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+/**
+ * queue. h
+ * <pre>
+ * void *pvQueueReserve( QueueHandle_t xQueue, TickType_t xTicksToWait );
+ * </pre>
+ *
+ * Reserve the next slot at the back of a queue so an item can be built
+ * directly in the queue storage instead of being copied in by xQueueSend().
+ * The slot counts as used, and the queue reads as full to other senders until
+ * vQueueCommit() is called, so only one reservation can be outstanding per
+ * queue.  xQueueOverwrite() also treats the queue as full until then.
+ *
+ * @param xQueue The handle to the queue.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for a free slot.
+ *
+ * @return A pointer to uxItemSize bytes of queue storage, or NULL if no slot
+ * became free within xTicksToWait.
+ *
+ * Example usage:
+ * <pre>
+ * struct AMessage *pxMessage = pvQueueReserve( xQueue, portMAX_DELAY );
+ * pxMessage->ucMessageID = 1;
+ * vQueueCommit( xQueue );
+ * </pre>
+ * \defgroup pvQueueReserve pvQueueReserve
+ * \ingroup QueueManagement
+ */
+    void * pvQueueReserve( QueueHandle_t xQueue,
+                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ * void vQueueCommit( QueueHandle_t xQueue );
+ * </pre>
+ *
+ * Post the item built in the slot returned by pvQueueReserve().  A task
+ * waiting to receive from the queue is unblocked as by xQueueSend().
+ *
+ * \defgroup vQueueCommit vQueueCommit
+ * \ingroup QueueManagement
+ */
+    void vQueueCommit( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ * void *pvQueuePeekInPlace( QueueHandle_t xQueue, TickType_t xTicksToWait );
+ * </pre>
+ *
+ * Return a pointer to the item at the front of a queue without copying it
+ * out.  The item stays in the queue, and its slot cannot be reused, until
+ * vQueueReleasePeeked() is called.  Only one item can be held at a time, and
+ * no other task may receive from the queue while it is held.
+ * xQueueSendToFront() and xQueueOverwrite() treat the queue as full while an
+ * item is held, as either would change the item vQueueReleasePeeked() removes.
+ *
+ * @param xQueue The handle to the queue.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item.
+ *
+ * @return A pointer to the item in the queue storage, or NULL if the queue
+ * stayed empty for xTicksToWait.
+ *
+ * \defgroup pvQueuePeekInPlace pvQueuePeekInPlace
+ * \ingroup QueueManagement
+ */
+    void * pvQueuePeekInPlace( QueueHandle_t xQueue,
+                               TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ * void vQueueReleasePeeked( QueueHandle_t xQueue );
+ * </pre>
+ *
+ * Remove the item returned by pvQueuePeekInPlace() from the queue.  A task
+ * waiting to send to the queue is unblocked as by xQueueReceive().
+ *
+ * \defgroup vQueueReleasePeeked vQueueReleasePeeked
+ * \ingroup QueueManagement
+ */
+    void vQueueReleasePeeked( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_QUEUE_ZERO_COPY */
+
 #if ( configUSE_PRIORITY_CEILING_PROTOCOL == 1 )
     /*
-     * Initialize the priority ceiling of mutexes.
+     * Initialize the priority ceiling of mutexes. Calling it again for the same mutex
+     * updates its ceiling.
      */
     void vInitializePriorityCeiling( QueueHandle_t xQueue, UBaseType_t uxCeilingPriority );
 
@@ -0,0 +1,285 @@
+/*
+ * FreeRTOS Kernel V10.4.3
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "Arduino_FreeRTOS.h"
+#include "task.h"
+#include "ring_channel.h"
+
+#if ( configUSE_TASK_NOTIFICATIONS != 1 )
+    #error configUSE_TASK_NOTIFICATIONS must be set to 1 to build ring_channel.c
+#endif
+
+#if ( INCLUDE_xTaskGetCurrentTaskHandle != 1 )
+    #error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 to build ring_channel.c
+#endif
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the index after ucIndex.  The length need not be a power of two, so
+ * the index wraps by comparison rather than by masking.
+ */
+static uint8_t prvNextIndex( const RingChannel_t * const pxChannel,
+                             uint8_t ucIndex ) PRIVILEGED_FUNCTION;
+
+/*
+ * Writes one item.  Common to the task and interrupt versions; returns pdFAIL
+ * if the channel is full.
+ */
+static BaseType_t prvWriteItem( RingChannel_t * const pxChannel,
+                                const void * pvItem ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    RingChannelHandle_t xRingChannelCreate( UBaseType_t uxLength,
+                                            UBaseType_t uxItemSize )
+    {
+        uint8_t * pucAllocatedMemory;
+
+        /* The channel structure and its storage are allocated together. */
+        pucAllocatedMemory = ( uint8_t * ) pvPortMalloc( sizeof( RingChannel_t ) + ( ( size_t ) uxLength * ( size_t ) uxItemSize ) );
+
+        if( pucAllocatedMemory == NULL )
+        {
+            return NULL;
+        }
+
+        return xRingChannelCreateStatic( uxLength, uxItemSize, pucAllocatedMemory + sizeof( RingChannel_t ), ( RingChannel_t * ) pucAllocatedMemory ); /*lint !e9087 !e826 Safe cast as portBYTE_ALIGNMENT is 1. */
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+RingChannelHandle_t xRingChannelCreateStatic( UBaseType_t uxLength,
+                                              UBaseType_t uxItemSize,
+                                              uint8_t * pucStorage,
+                                              RingChannel_t * pxChannel )
+{
+    configASSERT( pucStorage );
+    configASSERT( pxChannel );
+    configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+    /* The indices are single bytes so they can be updated without a critical
+     * section, which limits the length.  UBaseType_t is already a single byte
+     * on this port, so only the lower bound needs checking. */
+    configASSERT( uxLength >= ( UBaseType_t ) 2 );
+
+    pxChannel->pucStorage = pucStorage;
+    pxChannel->uxItemSize = uxItemSize;
+    pxChannel->ucLength = ( uint8_t ) uxLength;
+    pxChannel->ucHead = 0U;
+    pxChannel->ucTail = 0U;
+    pxChannel->ucReaderWaiting = pdFALSE;
+    pxChannel->xReader = NULL;
+
+    return pxChannel;
+}
+/*-----------------------------------------------------------*/
+
+static uint8_t prvNextIndex( const RingChannel_t * const pxChannel,
+                             uint8_t ucIndex )
+{
+    ucIndex++;
+
+    if( ucIndex >= pxChannel->ucLength )
+    {
+        ucIndex = 0U;
+    }
+
+    return ucIndex;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWriteItem( RingChannel_t * const pxChannel,
+                                const void * pvItem )
+{
+    uint8_t ucHead = pxChannel->ucHead;
+    uint8_t ucNext = prvNextIndex( pxChannel, ucHead );
+
+    if( ucNext == pxChannel->ucTail )
+    {
+        return pdFAIL;
+    }
+
+    ( void ) memcpy( ( void * ) ( pxChannel->pucStorage + ( ( size_t ) ucHead * pxChannel->uxItemSize ) ), pvItem, ( size_t ) pxChannel->uxItemSize );
+
+    /* The item must be in place before the reader can see the new head. */
+    portMEMORY_BARRIER();
+    pxChannel->ucHead = ucNext;
+    portMEMORY_BARRIER();
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRingChannelSendFromISR( RingChannelHandle_t xChannel,
+                                    const void * pvItem,
+                                    BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    RingChannel_t * const pxChannel = xChannel;
+
+    configASSERT( pxChannel );
+
+    if( prvWriteItem( pxChannel, pvItem ) == pdFAIL )
+    {
+        return pdFAIL;
+    }
+
+    /* Only a reader that has said it is about to block needs the kernel. */
+    if( pxChannel->ucReaderWaiting != pdFALSE )
+    {
+        pxChannel->ucReaderWaiting = pdFALSE;
+        vTaskNotifyGiveFromISR( pxChannel->xReader, pxHigherPriorityTaskWoken );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRingChannelSend( RingChannelHandle_t xChannel,
+                             const void * pvItem )
+{
+    RingChannel_t * const pxChannel = xChannel;
+
+    configASSERT( pxChannel );
+
+    if( prvWriteItem( pxChannel, pvItem ) == pdFAIL )
+    {
+        return pdFAIL;
+    }
+
+    if( pxChannel->ucReaderWaiting != pdFALSE )
+    {
+        pxChannel->ucReaderWaiting = pdFALSE;
+        ( void ) xTaskNotifyGive( pxChannel->xReader );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xRingChannelReceive( RingChannelHandle_t xChannel,
+                                void * pvBuffer,
+                                TickType_t xTicksToWait )
+{
+    RingChannel_t * const pxChannel = xChannel;
+    TimeOut_t xTimeOut;
+    uint8_t ucTail;
+
+    configASSERT( pxChannel );
+    configASSERT( pvBuffer );
+
+    vTaskSetTimeOutState( &xTimeOut );
+
+    for( ; ; )
+    {
+        ucTail = pxChannel->ucTail;
+
+        if( ucTail != pxChannel->ucHead )
+        {
+            break;
+        }
+
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+        {
+            return pdFAIL;
+        }
+
+        /* Announce the wait, then look again: an item written before the
+         * flag was visible would otherwise not notify and be missed until
+         * the next one. */
+        pxChannel->xReader = xTaskGetCurrentTaskHandle();
+        portMEMORY_BARRIER();
+        pxChannel->ucReaderWaiting = pdTRUE;
+        portMEMORY_BARRIER();
+
+        if( pxChannel->ucTail == pxChannel->ucHead )
+        {
+            ( void ) ulTaskNotifyTake( pdTRUE, xTicksToWait );
+        }
+
+        /* A notification left over from an earlier wait only causes one extra
+         * pass round the loop. */
+        pxChannel->ucReaderWaiting = pdFALSE;
+    }
+
+    portMEMORY_BARRIER();
+    ( void ) memcpy( pvBuffer, ( const void * ) ( pxChannel->pucStorage + ( ( size_t ) ucTail * pxChannel->uxItemSize ) ), ( size_t ) pxChannel->uxItemSize );
+
+    /* The slot must be copied out before the writer can see it is free. */
+    portMEMORY_BARRIER();
+    pxChannel->ucTail = prvNextIndex( pxChannel, ucTail );
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxRingChannelItemsWaiting( RingChannelHandle_t xChannel )
+{
+    const RingChannel_t * const pxChannel = xChannel;
+    uint8_t ucHead, ucTail;
+
+    configASSERT( pxChannel );
+
+    ucHead = pxChannel->ucHead;
+    ucTail = pxChannel->ucTail;
+
+    if( ucHead >= ucTail )
+    {
+        return ( UBaseType_t ) ( ucHead - ucTail );
+    }
+    else
+    {
+        return ( UBaseType_t ) ( ( uint8_t ) ( pxChannel->ucLength - ucTail ) + ucHead );
+    }
+}
+/*-----------------------------------------------------------*/
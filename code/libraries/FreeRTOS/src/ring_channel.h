@@ -0,0 +1,209 @@
+/*
+ * FreeRTOS Kernel V10.4.3
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Ring channels pass fixed size items from one interrupt (or task) to one
+ * task without masking interrupts.  The writer owns ucHead and the reader owns
+ * ucTail; each is a single byte, so on the AVR it is read and written in one
+ * instruction and neither side ever sees a half updated index.  An item is
+ * copied in before ucHead is advanced past it, and copied out before ucTail is
+ * advanced past it, so the two sides never touch the same slot at once.
+ *
+ * ***NOTE***:  Exactly one writer and one reader are supported.  If several
+ * interrupts or tasks write to the same channel, each call to a send function
+ * must be made inside a critical section, which defeats the purpose - use a
+ * queue instead.
+ *
+ * The reader can block for data.  While it is blocked it sets ucReaderWaiting,
+ * and only then does the writer notify it, so a reader that polls costs the
+ * writer nothing beyond the copy.  The notification uses the task's direct to
+ * task notification, so the reader must not wait on its notification for
+ * anything else at the same time.
+ */
+
+#ifndef RING_CHANNEL_H
+#define RING_CHANNEL_H
+
+#ifndef INC_ARDUINO_FREERTOS_H
+    #error "include Arduino_FreeRTOS.h must appear in source files before include ring_channel.h"
+#endif
+
+#include "task.h"
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/*
+ * The channel itself.  It is declared here so channels can be created
+ * statically with xRingChannelCreateStatic(); its members must only be
+ * accessed through the functions below.
+ */
+typedef struct RingChannelDefinition
+{
+    uint8_t * pucStorage;            /*< Start of the storage area, ucLength * uxItemSize bytes. */
+    UBaseType_t uxItemSize;          /*< Size of each item in bytes. */
+    uint8_t ucLength;                /*< Number of slots.  One is always left empty so a full channel can be told from an empty one. */
+    volatile uint8_t ucHead;         /*< Next slot to write.  Only changed by the writer. */
+    volatile uint8_t ucTail;         /*< Next slot to read.  Only changed by the reader. */
+    volatile uint8_t ucReaderWaiting; /*< Set by the reader while it is blocked waiting for an item. */
+    TaskHandle_t xReader;            /*< The task to notify when ucReaderWaiting is set. */
+} RingChannel_t;
+
+typedef RingChannel_t * RingChannelHandle_t;
+
+/**
+ * ring_channel.h
+ *
+ * <pre>
+ * RingChannelHandle_t xRingChannelCreate( UBaseType_t uxLength, UBaseType_t uxItemSize );
+ * </pre>
+ *
+ * Creates a ring channel that can hold uxLength - 1 items of uxItemSize bytes.
+ * uxLength must be between 2 and 255.
+ *
+ * @return The handle of the channel, or NULL if there was not enough heap.
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    RingChannelHandle_t xRingChannelCreate( UBaseType_t uxLength,
+                                            UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * ring_channel.h
+ *
+ * <pre>
+ * RingChannelHandle_t xRingChannelCreateStatic( UBaseType_t uxLength, UBaseType_t uxItemSize, uint8_t *pucStorage, RingChannel_t *pxChannel );
+ * </pre>
+ *
+ * As xRingChannelCreate(), but using the caller's storage area, which must be
+ * at least uxLength * uxItemSize bytes, and channel structure.
+ */
+RingChannelHandle_t xRingChannelCreateStatic( UBaseType_t uxLength,
+                                              UBaseType_t uxItemSize,
+                                              uint8_t * pucStorage,
+                                              RingChannel_t * pxChannel ) PRIVILEGED_FUNCTION;
+
+/**
+ * ring_channel.h
+ *
+ * <pre>
+ * BaseType_t xRingChannelSendFromISR( RingChannelHandle_t xChannel, const void *pvItem, BaseType_t *pxHigherPriorityTaskWoken );
+ * </pre>
+ *
+ * Copies one item into the channel from an interrupt.  Interrupts are only
+ * masked, briefly, if the reader is blocked and has to be notified.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the reader was unblocked
+ * and has a higher priority than the interrupted task, in which case a
+ * context switch should be requested before the interrupt exits.
+ *
+ * @return pdPASS if the item was written, or pdFAIL if the channel was full.
+ */
+BaseType_t xRingChannelSendFromISR( RingChannelHandle_t xChannel,
+                                    const void * pvItem,
+                                    BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * ring_channel.h
+ *
+ * <pre>
+ * BaseType_t xRingChannelSend( RingChannelHandle_t xChannel, const void *pvItem );
+ * </pre>
+ *
+ * Copies one item into the channel from a task.  Never blocks.
+ *
+ * @return pdPASS if the item was written, or pdFAIL if the channel was full.
+ */
+BaseType_t xRingChannelSend( RingChannelHandle_t xChannel,
+                             const void * pvItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * ring_channel.h
+ *
+ * <pre>
+ * BaseType_t xRingChannelReceive( RingChannelHandle_t xChannel, void *pvBuffer, TickType_t xTicksToWait );
+ * </pre>
+ *
+ * Copies the oldest item out of the channel, blocking for up to xTicksToWait
+ * ticks if it is empty.  Must be called by the one reader task.
+ *
+ * @return pdPASS if an item was received, or pdFAIL if the timeout expired.
+ *
+ * Example usage:
+ * <pre>
+ * static uint8_t ucStorage[ 16 * sizeof( uint16_t ) ];
+ * static RingChannel_t xAdcChannel;
+ *
+ * ISR( ADC_vect )
+ * {
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ * uint16_t usSample = ADC;
+ *
+ *     xRingChannelSendFromISR( &xAdcChannel, &usSample, &xHigherPriorityTaskWoken );
+ *     if( xHigherPriorityTaskWoken ) taskYIELD();
+ * }
+ *
+ * void vSetup( void )
+ * {
+ *     xRingChannelCreateStatic( 16, sizeof( uint16_t ), ucStorage, &xAdcChannel );
+ * }
+ *
+ * void vReader( void *pvParameters )
+ * {
+ * uint16_t usSample;
+ *
+ *     for( ;; )
+ *     {
+ *         xRingChannelReceive( &xAdcChannel, &usSample, portMAX_DELAY );
+ *     }
+ * }
+ * </pre>
+ */
+BaseType_t xRingChannelReceive( RingChannelHandle_t xChannel,
+                                void * pvBuffer,
+                                TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * ring_channel.h
+ *
+ * <pre>
+ * UBaseType_t uxRingChannelItemsWaiting( RingChannelHandle_t xChannel );
+ * </pre>
+ *
+ * @return The number of items in the channel.  Safe to call from either side.
+ */
+UBaseType_t uxRingChannelItemsWaiting( RingChannelHandle_t xChannel ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( RING_CHANNEL_H ) */
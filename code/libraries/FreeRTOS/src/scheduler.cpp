@@ -4,12 +4,62 @@
 
 #define schedUSE_TCB_ARRAY 1
 
+#if( schedUSE_PREEMPTION_THRESHOLDS == 1 || schedUSE_SRP == 1 || schedUSE_MIXED_CRITICALITY == 1 || schedUSE_DUAL_PRIORITY == 1 || schedUSE_OPTIMAL_PRIORITY_ASSIGNMENT == 1 )
+	#define schedUSE_RESPONSE_TIME_ANALYSIS 1
+#else
+	#define schedUSE_RESPONSE_TIME_ANALYSIS 0
+#endif
+
+#if( schedUSE_SPORADIC_SERVER == 1 && schedUSE_SCHEDULER_TASK != 1 )
+	#error "The sporadic server requires schedUSE_SCHEDULER_TASK"
+#endif
+
+#if( schedUSE_MIXED_CRITICALITY == 1 && ( schedUSE_SCHEDULER_TASK != 1 || schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME != 1 ) )
+	#error "Mixed criticality requires schedUSE_SCHEDULER_TASK and schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME"
+#endif
+
+#if( schedUSE_MODES == 1 && schedUSE_SCHEDULER_TASK != 1 )
+	#error "Mode changes require schedUSE_SCHEDULER_TASK"
+#endif
+
+#if( schedUSE_TIMING_CHANGES == 1 && schedUSE_SCHEDULER_TASK != 1 )
+	#error "Timing changes require schedUSE_SCHEDULER_TASK"
+#endif
+
+#if( schedUSE_ELASTIC_TASKS == 1 && ( schedUSE_SCHEDULER_TASK != 1 || schedUSE_TIMING_CHANGES != 1 ) )
+	#error "Elastic tasks require schedUSE_SCHEDULER_TASK and schedUSE_TIMING_CHANGES"
+#endif
+
+#if( schedUSE_OPTIMAL_PRIORITY_ASSIGNMENT == 1 && schedSCHEDULING_POLICY != schedSCHEDULING_POLICY_RMS && schedSCHEDULING_POLICY != schedSCHEDULING_POLICY_DMS )
+	#error "Optimal priority assignment requires the RMS or DMS scheduling policy"
+#endif
+
+#if( schedUSE_DUAL_PRIORITY == 1 && schedUSE_SCHEDULER_TASK != 1 )
+	#error "Dual priority scheduling requires schedUSE_SCHEDULER_TASK"
+#endif
+
+#if( schedUSE_MK_FIRM == 1 && ( schedUSE_SCHEDULER_TASK != 1 || schedUSE_TIMING_ERROR_DETECTION_DEADLINE != 1 ) )
+	#error "(m,k)-firm tasks require schedUSE_SCHEDULER_TASK and schedUSE_TIMING_ERROR_DETECTION_DEADLINE"
+#endif
+
+#if( schedUSE_CBS == 1 && schedUSE_SCHEDULER_TASK != 1 )
+	#error "CBS reservations require schedUSE_SCHEDULER_TASK"
+#endif
+
+#if( schedUSE_RELEASE_CALENDAR == 1 && schedUSE_SCHEDULER_TASK != 1 )
+	#error "The release calendar requires schedUSE_SCHEDULER_TASK"
+#endif
+
+/* Response-time analysis gives up on a busy period longer than this many jobs of the
+ * task under analysis and reports the task as unschedulable. */
+#define RTA_MAX_JOBS_PER_BUSY_PERIOD 32
+
 /* Extended Task control block for managing periodic tasks within this library. */
 typedef struct xExtended_TCB
 {
 	TaskFunction_t pvTaskCode; 		/* Function pointer to the code that will be run periodically. */
 	const char *pcName; 			/* Name of the task. */
-	UBaseType_t uxStackDepth; 		/* Stack size of the task. */
+	configSTACK_DEPTH_TYPE uxStackDepth; 	/* Stack size of the task. */
 	void *pvParameters; 			/* Parameters to the task function. */
 	UBaseType_t uxPriority; 		/* Priority of the task. */
 	TaskHandle_t *pxTaskHandle;		/* Task handle for the task. */
@@ -25,7 +75,6 @@ typedef struct xExtended_TCB
 	BaseType_t xWorkIsDone; 		/* pdFALSE if the job is not finished, pdTRUE if the job is finished. */
 
 	#if( schedUSE_TCB_ARRAY == 1 )
-		BaseType_t xPriorityIsSet;	/* pdTRUE if the priority is assigned. */
 		BaseType_t xInUse; 			/* pdFALSE if this extended TCB is empty. */
 	#endif
 
@@ -46,6 +95,94 @@ typedef struct xExtended_TCB
 		SemaphoreHandle_t xAcquiredSemaphores[MAX_SEMAPHORES_PER_TASK];	/* Array to maintain a list of semaphores acquired by the task. */
 		BaseType_t xSemaphoreCount;										/* Number of semaphores currently acquired by the task. */
 	#endif
+
+	#if( schedUSE_PREEMPTION_THRESHOLDS == 1 )
+		UBaseType_t uxPreemptionThreshold;	/* Priority the task runs at while a job executes. */
+		BaseType_t xThresholdIsSet;			/* pdTRUE if the threshold was given by the user. */
+	#endif /* schedUSE_PREEMPTION_THRESHOLDS */
+
+	#if( schedUSE_MIXED_CRITICALITY == 1 )
+		BaseType_t xCriticality;			/* schedCRITICALITY_LO or schedCRITICALITY_HI. */
+		TickType_t xHiMaxExecTime;			/* Budget in HI mode. xMaxExecTime is the budget in LO mode. */
+		BaseType_t xDropped;				/* pdTRUE while a LO task is suspended in HI mode. */
+		volatile BaseType_t xDropPending;	/* pdTRUE while a LO task is to be dropped once it holds no resource. */
+	#endif /* schedUSE_MIXED_CRITICALITY */
+
+	#if( schedUSE_MODES == 1 )
+		UBaseType_t uxModeMask;					/* Bit n is set if the task belongs to mode n. */
+		TickType_t xPhase;						/* Offset of the first release after the task enters a mode. */
+		volatile BaseType_t xRetired;			/* pdTRUE while the task is suspended because it is not part of the current mode. */
+		volatile BaseType_t xModeReleasePending;	/* pdTRUE if the task was resumed by a mode change and has not been released yet. */
+		TickType_t xModeReleaseTime;			/* Idle instant at which the mode change released the task. */
+	#endif /* schedUSE_MODES */
+
+	#if( schedUSE_TIMING_CHANGES == 1 )
+		volatile BaseType_t xTimingChangePending;	/* pdTRUE if new timing parameters wait for the next release. */
+		TickType_t xPendingPeriod;					/* Period from the next release on. */
+		TickType_t xPendingRelativeDeadline;		/* Relative deadline from the next release on. */
+		TickType_t xPendingMaxExecTime;				/* Worst-case execution time from the next release on. */
+		BaseType_t xPriorityIsStale;				/* pdTRUE if the task could not be given its new priority while it held a resource. */
+	#endif /* schedUSE_TIMING_CHANGES */
+
+	#if( schedUSE_DUAL_PRIORITY == 1 )
+		TickType_t xPromotionOffset;		/* D - R, 0 if jobs start in the upper band. */
+		TickType_t xPromotionTime;			/* Tick count at which the current job enters the upper band. */
+		volatile BaseType_t xPromoted;		/* pdTRUE while the current job runs in the upper band. */
+		volatile BaseType_t xJobStarted;	/* pdTRUE once the current job got the processor in the lower band. */
+		volatile BaseType_t xPromotionDue;	/* pdTRUE if the tick hook asked the scheduler task to promote the job. */
+	#endif /* schedUSE_DUAL_PRIORITY */
+
+	#if( schedUSE_MK_FIRM == 1 )
+		BaseType_t xIsMKFirm;				/* pdTRUE if the task tolerates uxMaxMisses misses in any uxWindow jobs. */
+		UBaseType_t uxMaxMisses;			/* m, misses tolerated in any window of k jobs. */
+		UBaseType_t uxWindow;				/* k, at most 16. */
+		uint16_t usMissHistory;				/* Bit n is set if the job n releases ago missed its deadline or was skipped. */
+		volatile BaseType_t xMissTolerated;	/* pdTRUE if the deadline miss of the current job was accepted. */
+		UBaseType_t uxWindowPosition;		/* Position of the next release in its window of k, counted from the first release. */
+	#endif /* schedUSE_MK_FIRM */
+
+	#if( schedUSE_ELASTIC_TASKS == 1 )
+		UBaseType_t uxElasticity;			/* Elastic coefficient, 0 for a task whose period never changes. */
+		TickType_t xMinPeriod;				/* Period the task runs at while the load allows it. */
+		TickType_t xMaxPeriod;				/* Longest period the task accepts under overload. */
+		TickType_t xNominalDeadline;		/* Relative deadline at xMinPeriod, scaled with the period. */
+		TickType_t xElasticPeriod;			/* Period last requested by the elastic model. */
+		volatile uint32_t ulObservedExecTime;	/* Smoothed execution time of recent jobs, in 1/16 ticks. */
+	#endif /* schedUSE_ELASTIC_TASKS */
+
+	#if( schedUSE_SPORADIC_TASKS == 1 )
+		BaseType_t xIsSporadic;				/* pdTRUE if jobs are released by xSchedulerSporadicTaskReleaseFromISR(). xPeriod is then the minimum inter-arrival time. */
+		BaseType_t xReleasedOnce;			/* pdTRUE once the first sporadic job was released. */
+		volatile BaseType_t xReleasePending;	/* pdTRUE if an interrupt requested a release that no job has served yet. */
+		volatile TickType_t xPendingReleaseTime;	/* Tick count of the pending release request. */
+	#endif /* schedUSE_SPORADIC_TASKS */
+
+	#if( schedUSE_CBS == 1 )
+		BaseType_t xHasReservation;				/* pdTRUE if the task is a soft task served by a CBS. */
+		TickType_t xServerPeriod;				/* Server period T. The budget Q is xMaxExecTime. */
+		volatile TickType_t xRemainingBudget;	/* Server budget left in ticks. */
+		volatile TickType_t xServerDeadline;	/* Current server deadline. */
+		volatile BaseType_t xIsDemoted;			/* pdTRUE from budget exhaustion until the old server deadline. */
+		volatile BaseType_t xPriorityLowered;	/* pdTRUE once the scheduler task moved a demoted task to background priority. */
+		volatile BaseType_t xRestorePending;	/* pdTRUE when the old server deadline passed and the priority is to be restored. */
+	#endif /* schedUSE_CBS */
+
+	#if( schedUSE_SRP == 1 )
+		UBaseType_t uxSRPBasePriority;		/* Priority the task ran at before it took its first resource. */
+		volatile BaseType_t xSRPJobActive;	/* pdTRUE while a started job of a resource user has not finished. */
+		volatile BaseType_t xSRPWaiting;	/* pdTRUE while a job waits for the system ceiling to let it start. */
+	#endif /* schedUSE_SRP */
+
+	#if( schedUSE_RELEASE_CALENDAR == 1 )
+		struct xExtended_TCB *pxNextRelease;	/* Next task in the release calendar. */
+		TickType_t xNextReleaseTime;			/* Release the task waits for in the calendar. */
+		volatile BaseType_t xReleaseQueued;		/* pdTRUE while the task waits in the release calendar. */
+		TickType_t xMaxReleaseJitter;			/* Longest delay from a release to the start of its job, in ticks. */
+	#endif /* schedUSE_RELEASE_CALENDAR */
+
+	#if( schedUSE_TELEMETRY == 1 )
+		configSTACK_DEPTH_TYPE uxStackHighWaterMark;	/* Least free stack observed across all jobs of the task, including recreated instances. */
+	#endif /* schedUSE_TELEMETRY */
 	
 } SchedTCB_t;
 
@@ -62,6 +199,112 @@ static TickType_t xSystemStartTime = 0;
 
 static void prvPeriodicTaskCode( void *pvParameters );
 static void prvCreateAllTasks( void );
+/* Blocks the calling task until xLastWakeTime + xTimeIncrement and sets xLastWakeTime
+ * to it, like xTaskDelayUntil(). */
+static void prvWaitForNextRelease( SchedTCB_t *pxThisTask, TickType_t xTimeIncrement );
+
+#if( schedUSE_RELEASE_CALENDAR == 1 )
+	/* Tasks waiting for their next release, earliest release first. */
+	static SchedTCB_t *pxReleaseCalendar = NULL;
+
+	/* Inserts pxTCB at its release time. Must be called in a critical section. */
+	static void prvReleaseCalendarInsert( SchedTCB_t *pxTCB, TickType_t xTickCount );
+	/* Takes pxTCB out of the calendar before its task is deleted. */
+	static void prvReleaseCalendarRemove( SchedTCB_t *pxTCB );
+	/* Called from the tick hook. Releases every task whose release is due. */
+	static void prvReleaseCalendarTick( TickType_t xTickCount );
+#endif /* schedUSE_RELEASE_CALENDAR */
+
+#if( schedUSE_MIXED_CRITICALITY == 1 )
+	/* Criticality the system currently runs at. */
+	static volatile BaseType_t xSystemCriticality = schedCRITICALITY_LO;
+	/* pdTRUE if the scheduler task has to drop LO tasks after a switch to HI mode. */
+	static volatile BaseType_t xCriticalityRaised = pdFALSE;
+	/* pdTRUE if the tick hook saw an idle instant in HI mode. */
+	static volatile BaseType_t xCriticalityLowered = pdFALSE;
+
+	/* Budget of a task when the system runs at xCriticality. */
+	static TickType_t prvGetMaxExecTime( SchedTCB_t *pxTCB, BaseType_t xCriticality );
+	/* Called from the scheduler task. Drops LO tasks in HI mode and releases them again in LO mode. */
+	static void prvCriticalityUpdate( void );
+#endif /* schedUSE_MIXED_CRITICALITY */
+
+#if( schedUSE_MODES == 1 )
+	/* Progress of a mode change. */
+	typedef enum
+	{
+		eModeStable,			/* No mode change in progress. */
+		eModeRetiring,			/* Waiting for tasks outside the new mode to retire. */
+		eModeWaitingForIdle,	/* Waiting for an idle instant. */
+		eModeReleaseDue			/* The scheduler task is to release the tasks of the new mode. */
+	} ModeChangeState_t;
+
+	/* Names of the created modes. */
+	static const char *pcModeNames[ schedMAX_NUMBER_OF_MODES ];
+	/* Counter for number of created modes. */
+	static BaseType_t xModeCounter = 0;
+	static volatile BaseType_t xCurrentMode = 0;
+	static volatile BaseType_t xTargetMode = 0;
+	static volatile ModeChangeState_t eModeChangeState = eModeStable;
+
+	/* Returns pdTRUE if pxTCB belongs to xMode. */
+	static BaseType_t prvIsTaskInMode( SchedTCB_t *pxTCB, BaseType_t xMode );
+	/* Called at every release. Retires the calling task if it is not part of the mode being
+	 * entered, and places the first release after the task was resumed by a mode change. */
+	static void prvModeChangeRelease( SchedTCB_t *pxThisTask );
+	/* Called from the scheduler task. Advances a mode change in progress. */
+	static void prvModeChangeUpdate( void );
+	/* Suspends the tasks that are not part of the initial mode. */
+	static void prvSuspendTasksOutsideMode( void );
+#endif /* schedUSE_MODES */
+
+#if( schedUSE_TIMING_CHANGES == 1 )
+	/* pdTRUE if the scheduler task has to assign priorities again after a timing change. */
+	static volatile BaseType_t xReassignmentPending = pdFALSE;
+
+	/* Makes pending timing parameters of the calling task current and has priorities reassigned. */
+	static void prvApplyTimingChange( SchedTCB_t *pxThisTask );
+	/* Called from the scheduler task. Assigns priorities, thresholds and ceilings again
+	 * and hands the new priorities to the kernel. */
+	static void prvReassignPriorities( void );
+#endif /* schedUSE_TIMING_CHANGES */
+
+#if( schedUSE_DUAL_PRIORITY == 1 )
+	/* Sets the promotion offset of every task from its response time. */
+	static void prvDualPrioritySetOffsets( void );
+	/* Called from the scheduler task. Moves jobs whose promotion time has come to the upper band. */
+	static void prvDualPriorityUpdate( void );
+#endif /* schedUSE_DUAL_PRIORITY */
+
+#if( schedUSE_MK_FIRM == 1 )
+	/* Number of misses in the last k - 1 jobs, the ones that share a window with the next job. */
+	static UBaseType_t prvMKRecentMisses( SchedTCB_t *pxTCB );
+	/* Shifts the outcome of a job into the miss history. */
+	static void prvMKRecordJob( SchedTCB_t *pxTCB, BaseType_t xMissed );
+	/* Called once per release. Returns pdTRUE if the job being released is optional and
+	 * should be skipped because the task is falling behind. */
+	static BaseType_t prvMKShouldSkipJob( SchedTCB_t *pxThisTask );
+#endif /* schedUSE_MK_FIRM */
+
+#if( schedUSE_ELASTIC_TASKS == 1 )
+	/* Fraction bits of ulObservedExecTime. */
+	#define schedELASTIC_EXEC_TIME_SHIFT 4
+
+	/* Observed load at the nominal periods when the periods were last computed. */
+	static uint32_t ulElasticLastLoad = UINT32_MAX;
+
+	/* Adds the execution time of the job that just finished to the observed execution time. */
+	static void prvElasticRecordJob( SchedTCB_t *pxThisTask );
+	/* Utilisation of a task with observed execution time ulObservedExecTime and period xPeriod, scaled to 1024. */
+	static uint32_t prvElasticUtilisation( uint32_t ulObservedExecTime, TickType_t xPeriod );
+	/* Called from the scheduler task. Compresses or relaxes the periods of elastic tasks. */
+	static void prvElasticUpdate( void );
+#endif /* schedUSE_ELASTIC_TASKS */
+
+#if( schedUSE_SPORADIC_TASKS == 1 )
+	/* Blocks a sporadic task until its next release and sets xLastWakeTime to it. */
+	static void prvWaitForSporadicRelease( SchedTCB_t *pxThisTask );
+#endif /* schedUSE_SPORADIC_TASKS */
 
 /* Create a separate function to assign priorities for DM */
 #if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_RMS || schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_DMS )
@@ -91,6 +334,203 @@ static void prvCreateAllTasks( void );
 	BaseType_t xTaskResourceGive( SemaphoreHandle_t xSemaphore );
 #endif
 
+/* Returns the extended TCB created with the given pxCreatedTask pointer, or NULL. */
+static SchedTCB_t *prvGetTCBFromCreatedTask( TaskHandle_t *pxCreatedTask );
+
+#if( schedUSE_RESPONSE_TIME_ANALYSIS == 1 )
+	/* Worst-case response time of a task in ticks, UINT32_MAX if unbounded. */
+	static uint32_t prvResponseTime( SchedTCB_t *pxTask );
+	/* Worst-case response time of a job with WCET ulExecTime and period ulPeriod run by
+	 * the task at xTask, which is delayed until it starts by the first xJobsAbove periodic
+	 * jobs. UINT32_MAX if unbounded. */
+	static uint32_t prvResponseTimeOf( BaseType_t xTask, uint32_t ulExecTime, uint32_t ulPeriod, uint32_t ulBlocking, BaseType_t xJobsAbove );
+	/* Execution time requested by the task at xIndex in the releases in [0, ulTime), or
+	 * in [0, ulTime] if xClosed is pdTRUE. */
+	static uint32_t prvDemand( BaseType_t xIndex, uint32_t ulTime, BaseType_t xClosed );
+	/* Utilisation of the task at xIndex in 1/1024, rounded up. */
+	static uint32_t prvUtilisation( BaseType_t xIndex );
+	/* Highest priority a started job of pxTCB can block, through its threshold or resources. */
+	static UBaseType_t prvGetBlockingLevel( SchedTCB_t *pxTCB );
+	#if( schedUSE_MIXED_CRITICALITY == 1 )
+		/* Worst-case response time of a HI task across a switch to HI mode, UINT32_MAX if it exceeds the deadline. */
+		static uint32_t prvResponseTimeHI( SchedTCB_t *pxTask );
+	#endif /* schedUSE_MIXED_CRITICALITY */
+	/* Returns pdTRUE if every periodic task meets its deadline. Prints the response
+	 * time of every task when xReport is pdTRUE. */
+	static BaseType_t prvIsTaskSetSchedulable( BaseType_t xReport );
+	#if( schedUSE_OPTIMAL_PRIORITY_ASSIGNMENT == 1 )
+		/* Replaces the RMS/DMS priorities with an order found by Audsley's algorithm.
+		 * Returns pdFALSE and keeps the RMS/DMS priorities if no order is schedulable. */
+		static BaseType_t prvAssignOptimalPriorities( void );
+	#endif /* schedUSE_OPTIMAL_PRIORITY_ASSIGNMENT */
+#endif /* schedUSE_RESPONSE_TIME_ANALYSIS */
+
+#if( schedUSE_PREEMPTION_THRESHOLDS == 1 )
+	/* Returns the effective preemption threshold of a task. */
+	static UBaseType_t prvGetPreemptionThreshold( SchedTCB_t *pxTCB );
+	#if( schedAUTO_ASSIGN_PREEMPTION_THRESHOLDS == 1 )
+		/* Drops the thresholds of tasks without a user-given threshold back to their priority. */
+		static void prvClearPreemptionThresholds( void );
+		/* Raises the thresholds of tasks without a user-given threshold. */
+		static void prvAssignPreemptionThresholds( void );
+	#endif /* schedAUTO_ASSIGN_PREEMPTION_THRESHOLDS */
+#endif /* schedUSE_PREEMPTION_THRESHOLDS */
+
+#if( schedUSE_PERIODIC_JOBS == 1 )
+	/* Control block of a run-to-completion periodic job. */
+	typedef struct xPeriodicJob
+	{
+		TaskFunction_t pvJobCode;		/* Function called once per job release. */
+		const char *pcName;				/* Name of the job. */
+		void *pvParameters;				/* Parameters to the job function. */
+		TickType_t xPeriod;				/* Job period. */
+		TickType_t xMaxExecTime;		/* Worst-case execution time of the job. */
+		TickType_t xRelativeDeadline;	/* Relative deadline of the job. */
+		TickType_t xNextRelease;		/* Absolute time of the next release, the phase until vSchedulerStart is called. */
+		volatile TickType_t xExecTime;	/* Execution time of the running job, counted by the tick hook. */
+		#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 )
+			volatile BaseType_t xDeadlineExceeded;		/* pdTRUE when a job exceeded its deadline. */
+		#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE */
+		#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
+			volatile BaseType_t xMaxExecTimeExceeded;	/* pdTRUE when a job exceeded its WCET. */
+		#endif /* schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */
+	} SchedJob_t;
+
+	/* Array of periodic jobs, sorted by RMS/DMS priority in vSchedulerStart(). */
+	static SchedJob_t xJobArray[ schedMAX_NUMBER_OF_PERIODIC_JOBS ];
+	/* Counter for number of periodic jobs. */
+	static BaseType_t xJobCounter = 0;
+	/* Handle of the dispatcher task that runs all jobs. */
+	static TaskHandle_t xJobDispatcherHandle = NULL;
+	/* Job the dispatcher is running, NULL between jobs. */
+	static SchedJob_t * volatile pxRunningJob = NULL;
+
+	/* Body of the job dispatcher, executed once per dispatcher period. */
+	static void prvJobDispatcherCode( void *pvParameters );
+	/* Sorts the jobs and registers the dispatcher as a periodic task. */
+	static void prvCreateJobDispatcher( void );
+	#if( schedUSE_SCHEDULER_TASK == 1 && ( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 || schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 ) )
+		/* Reports the timing errors flagged for a job. Called by the scheduler task. */
+		static void prvSchedulerCheckJobTimingError( SchedJob_t *pxJob );
+	#endif /* schedUSE_SCHEDULER_TASK && ( schedUSE_TIMING_ERROR_DETECTION_DEADLINE || schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME ) */
+	#if( schedUSE_RESPONSE_TIME_ANALYSIS == 1 )
+		/* Execution time requested by the first xJobs jobs in the releases in [0, ulTime),
+		 * or in [0, ulTime] if xClosed is pdTRUE. */
+		static uint32_t prvJobDemand( BaseType_t xJobs, uint32_t ulTime, BaseType_t xClosed );
+		/* Utilisation of the first xJobs jobs in 1/1024, rounded up. */
+		static uint32_t prvJobUtilisation( BaseType_t xJobs );
+		/* Response time of the dispatcher, analysed job by job. See the definition. */
+		static uint32_t prvJobDispatcherResponseTime( BaseType_t xTask, uint32_t ulBlocking );
+	#endif /* schedUSE_RESPONSE_TIME_ANALYSIS */
+#endif /* schedUSE_PERIODIC_JOBS */
+
+#if( schedUSE_TELEMETRY == 1 )
+	/* Folds the current stack high-water mark of the task into pxTCB->uxStackHighWaterMark. */
+	static void prvUpdateStackHighWaterMark( SchedTCB_t *pxTCB );
+
+	#if( schedUSE_STACK_CALIBRATION == 1 && schedUSE_SCHEDULER_TASK == 1 )
+		/* Returns the least common multiple of all task periods, saturated to UINT32_MAX. */
+		static uint32_t prvGetHyperperiod( void );
+		/* Length of the calibration run in ticks. */
+		static uint32_t ulCalibrationTicks = 0;
+		/* Ticks elapsed since the calibration run started. */
+		static uint32_t ulCalibrationElapsedTicks = 0;
+		/* Tick count when the elapsed time was last accumulated. */
+		static TickType_t xCalibrationLastTick = 0;
+		static BaseType_t xCalibrationDone = pdFALSE;
+	#endif /* schedUSE_STACK_CALIBRATION */
+#endif /* schedUSE_TELEMETRY */
+
+#if( schedUSE_SPORADIC_SERVER == 1 )
+	/* An aperiodic job waiting for the sporadic server. */
+	typedef struct xAPERIODIC_JOB
+	{
+		TaskFunction_t pvJobCode;	/* Function called once for the job. */
+		void *pvParameters;			/* Parameters to the job function. */
+	} AperiodicJob_t;
+
+	/* Budget that is given back to the server at a given time. */
+	typedef struct xREPLENISHMENT
+	{
+		TickType_t xTime;			/* Tick count at which the budget is given back. */
+		TickType_t xAmount;			/* Budget given back. */
+	} Replenishment_t;
+
+	/* State of the sporadic server. The budget capacity is the WCET of its extended TCB. */
+	typedef struct xSPORADIC_SERVER
+	{
+		SchedTCB_t *pxTCB;							/* Extended TCB of the server task, NULL if there is no server. */
+		QueueHandle_t xJobQueue;					/* Aperiodic jobs waiting for the server. */
+		volatile TickType_t xRemainingBudget;		/* Budget left in ticks. */
+		volatile TickType_t xConsumedBudget;		/* Budget consumed since the server became active. */
+		volatile TickType_t xActivationTime;		/* Tick count at which the server became active. */
+		volatile BaseType_t xIsActive;				/* pdTRUE while consumed budget is waiting to be scheduled for replenishment. */
+		volatile BaseType_t xIsExhausted;			/* pdTRUE from budget exhaustion until the next replenishment. */
+		Replenishment_t xReplenishments[ schedSPORADIC_SERVER_MAX_REPLENISHMENTS ];	/* Pending replenishments, earliest first. */
+		volatile UBaseType_t uxReplenishmentCount;	/* Number of pending replenishments. */
+	} SporadicServer_t;
+
+	static SporadicServer_t xSporadicServer = { 0 };
+	static TaskHandle_t xSporadicServerHandle = NULL;
+
+	/* Body of the server task. Runs aperiodic jobs in FIFO order. */
+	static void prvSporadicServerCode( SchedTCB_t *pxThisTask );
+	/* Schedules the budget consumed since activation for replenishment. Called with interrupts disabled. */
+	static void prvSporadicServerDeactivate( void );
+	/* Called from the tick hook. Replenishes due budget and charges the server if it is running. */
+	static void prvSporadicServerTick( TickType_t xTickCount, BaseType_t xServerIsRunning );
+	/* Called from the scheduler task. Suspends the server if its budget is exhausted. */
+	static void prvSporadicServerCheckBudget( void );
+#endif /* schedUSE_SPORADIC_SERVER */
+
+#if( schedUSE_CBS == 1 )
+	/* Applies the CBS arrival rule when a job of a soft task is released. */
+	static void prvReservationRelease( SchedTCB_t *pxTCB );
+	/* Called from the tick hook. Charges a running soft task and postpones its deadline when the budget runs out. */
+	static void prvReservationCharge( SchedTCB_t *pxTCB );
+	/* Called from the scheduler task. Moves soft tasks to and from background priority. */
+	static void prvReservationUpdatePriorities( void );
+#endif /* schedUSE_CBS */
+
+#if( schedUSE_RESOURCE_DECLARATIONS == 1 )
+	/* A declared resource. Under the Stack Resource Policy the preemption level of a task
+	 * is its relative deadline, a shorter deadline being a higher level. */
+	typedef struct xSCHED_RESOURCE
+	{
+		SemaphoreHandle_t xSemaphore;	/* The declared resource. */
+		uint32_t ulUsers;				/* Bit n is set if the task in xTCBArray[ n ] uses the resource. */
+		TickType_t xCeilingLevel;		/* Highest preemption level among the users, as a relative deadline. */
+		UBaseType_t uxCeiling;			/* Priority the holder runs at while it holds the resource. */
+	} SchedResource_t;
+
+	/* Array of declared resources. */
+	static SchedResource_t xResourceArray[ schedMAX_NUMBER_OF_RESOURCES ];
+	/* Counter for number of declared resources. */
+	static BaseType_t xResourceCounter = 0;
+
+	/* Returns the declared resource for xSemaphore, or NULL. */
+	static SchedResource_t *prvGetResource( SemaphoreHandle_t xSemaphore );
+	/* Derives the ceiling of every resource in xAssignment from the preemption levels and priorities of all tasks. */
+	static void prvSetResourceCeilings( void );
+	/* Returns the highest ceiling in xAssignment among the resources used by a task, or its priority if it uses none. */
+	static UBaseType_t prvGetResourceCeilingOfTask( SchedTCB_t *pxTCB );
+#endif /* schedUSE_RESOURCE_DECLARATIONS */
+
+#if( schedUSE_SRP == 1 )
+	/* Returns pdTRUE if pxTCB declared at least one resource. */
+	static BaseType_t prvSRPIsUser( SchedTCB_t *pxTCB );
+	/* Returns pdTRUE if a job of pxTCB may start. Must be called in a critical section. */
+	static BaseType_t prvSRPMayStart( SchedTCB_t *pxTCB );
+	/* Blocks a resource user until its job may start and marks the job started. */
+	static void prvSRPWaitForStart( SchedTCB_t *pxThisTask );
+	/* Marks the job of pxTCB finished and lets waiting jobs check again. */
+	static void prvSRPJobEnd( SchedTCB_t *pxTCB );
+	/* Lets every waiting job check again. Must be called in a critical section. */
+	static void prvSRPWakeWaiters( void );
+	/* Priority the calling task runs at: its base priority raised to the ceilings of the resources it holds. */
+	static UBaseType_t prvSRPHolderPriority( SchedTCB_t *pxThisTask );
+#endif /* schedUSE_SRP */
+
 #if( schedUSE_TCB_ARRAY == 1 )
 	/* Array for extended TCBs. */
 	static SchedTCB_t xTCBArray[ schedMAX_NUMBER_OF_PERIODIC_TASKS ] = { 0 };
@@ -98,6 +538,37 @@ static void prvCreateAllTasks( void );
 	static BaseType_t xTaskCounter = 0;
 #endif /* schedUSE_TCB_ARRAY */
 
+#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_RMS || schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_DMS )
+	/* Priorities, thresholds and ceilings of the whole task set while they are computed,
+	 * indexed like xTCBArray and xResourceArray. The analysis only works on this copy;
+	 * tasks read the values prvPublishAssignment() copied to their extended TCBs. */
+	typedef struct xSCHED_ASSIGNMENT
+	{
+		UBaseType_t uxPriority[ schedMAX_NUMBER_OF_PERIODIC_TASKS ];
+		BaseType_t xPriorityIsSet[ schedMAX_NUMBER_OF_PERIODIC_TASKS ];	/* pdTRUE once the task got a priority in the current pass. */
+		#if( schedUSE_PREEMPTION_THRESHOLDS == 1 )
+			UBaseType_t uxPreemptionThreshold[ schedMAX_NUMBER_OF_PERIODIC_TASKS ];
+		#endif /* schedUSE_PREEMPTION_THRESHOLDS */
+		#if( schedUSE_DUAL_PRIORITY == 1 )
+			TickType_t xPromotionOffset[ schedMAX_NUMBER_OF_PERIODIC_TASKS ];
+		#endif /* schedUSE_DUAL_PRIORITY */
+		#if( schedUSE_RESOURCE_DECLARATIONS == 1 )
+			UBaseType_t uxCeiling[ schedMAX_NUMBER_OF_RESOURCES ];
+			TickType_t xCeilingLevel[ schedMAX_NUMBER_OF_RESOURCES ];
+		#endif /* schedUSE_RESOURCE_DECLARATIONS */
+	} SchedAssignment_t;
+
+	static SchedAssignment_t xAssignment;
+
+	/* Computes priorities, resource ceilings, thresholds and promotion offsets of the
+	 * task set in xAssignment. Returns pdTRUE if the priorities come from Audsley's
+	 * algorithm instead of RMS/DMS. */
+	static BaseType_t prvAssignPriorities( void );
+	/* Copies xAssignment to the extended TCBs and resources. Once the scheduler runs,
+	 * the caller must keep tasks from running meanwhile. */
+	static void prvPublishAssignment( void );
+#endif /* schedSCHEDULING_POLICY */
+
 #if( schedUSE_SCHEDULER_TASK )
 	static TickType_t xSchedulerWakeCounter = 0;
 	static TaskHandle_t xSchedulerHandle = NULL;
@@ -209,6 +680,29 @@ static void prvPeriodicTaskCode( void *pvParameters )
 		pxThisTask->xExecutedOnce = pdTRUE;
 	#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE */
     
+	#if( schedUSE_SPORADIC_SERVER == 1 )
+		if( pxThisTask == xSporadicServer.pxTCB )
+		{
+			/* Does not return. */
+			prvSporadicServerCode( pxThisTask );
+		}
+	#endif /* schedUSE_SPORADIC_SERVER */
+
+	#if( schedUSE_MODES == 1 )
+		if( pdTRUE == pxThisTask->xModeReleasePending )
+		{
+			/* Released by a mode change at the top of the loop. */
+		}
+		else
+	#endif /* schedUSE_MODES */
+	#if( schedUSE_SPORADIC_TASKS == 1 )
+		if( pdTRUE == pxThisTask->xIsSporadic )
+		{
+			pxThisTask->xWorkIsDone = pdTRUE;
+			prvWaitForSporadicRelease( pxThisTask );
+		}
+		else
+	#endif /* schedUSE_SPORADIC_TASKS */
 	if( 0 == pxThisTask->xReleaseTime )
 	{
 		pxThisTask->xLastWakeTime = xSystemStartTime;
@@ -218,7 +712,7 @@ static void prvPeriodicTaskCode( void *pvParameters )
 		/* your implementation goes here:
 			1. Delay the task until its release time before it executes for the first time.
 		*/
-		xTaskDelayUntil( &pxThisTask->xLastWakeTime, pxThisTask->xReleaseTime );
+		prvWaitForNextRelease( pxThisTask, pxThisTask->xReleaseTime );
 	}
 
 	TaskStatus_t xTaskDetails;
@@ -235,14 +729,123 @@ static void prvPeriodicTaskCode( void *pvParameters )
 		// Serial.print( "; CP=" );
 		// Serial.println( xTaskDetails.uxCurrentPriority );
 
+		#if( schedUSE_MODES == 1 )
+			prvModeChangeRelease( pxThisTask );
+		#endif /* schedUSE_MODES */
+
+		#if( schedUSE_TIMING_CHANGES == 1 )
+			if( pdTRUE == pxThisTask->xTimingChangePending )
+			{
+				prvApplyTimingChange( pxThisTask );
+			}
+			if( pdTRUE == pxThisTask->xPriorityIsStale )
+			{
+				pxThisTask->xPriorityIsStale = pdFALSE;
+				#if( schedUSE_CBS == 1 )
+					if( pdFALSE == pxThisTask->xPriorityLowered )
+				#endif /* schedUSE_CBS */
+				vTaskPrioritySet( NULL, pxThisTask->uxPriority );
+			}
+		#endif /* schedUSE_TIMING_CHANGES */
+
+		#if( schedUSE_MK_FIRM == 1 )
+			if( pdTRUE == pxThisTask->xIsMKFirm && pdTRUE == prvMKShouldSkipJob( pxThisTask ) )
+			{
+				/* The skipped job counts as a miss, the task waits for its next release. */
+				prvMKRecordJob( pxThisTask, pdTRUE );
+				prvWaitForNextRelease( pxThisTask, pxThisTask->xPeriod );
+				continue;
+			}
+		#endif /* schedUSE_MK_FIRM */
+
 		/* your implementation goes here: 
 			1. Set xWorkIsDone to pdFALSE;
 		*/
 		pxThisTask->xWorkIsDone = pdFALSE;
 
+		#if( schedUSE_DUAL_PRIORITY == 1 )
+			if( pxThisTask->xPromotionOffset > 0 )
+			{
+				/* The job starts below background work and enters the upper band D - R after its release. */
+				taskENTER_CRITICAL();
+				pxThisTask->xPromotionTime = pxThisTask->xLastWakeTime + pxThisTask->xPromotionOffset;
+				pxThisTask->xPromoted = pdFALSE;
+				pxThisTask->xJobStarted = pdFALSE;
+				vTaskPrioritySet( NULL, schedDUAL_PRIORITY_LOWER_BAND );
+				taskEXIT_CRITICAL();
+			}
+		#endif /* schedUSE_DUAL_PRIORITY */
+
+		#if( schedUSE_CBS == 1 )
+			if( pdTRUE == pxThisTask->xHasReservation )
+			{
+				prvReservationRelease( pxThisTask );
+			}
+		#endif /* schedUSE_CBS */
+
+		#if( schedUSE_SRP == 1 )
+			prvSRPWaitForStart( pxThisTask );
+		#endif /* schedUSE_SRP */
+
+		#if( schedUSE_PREEMPTION_THRESHOLDS == 1 && schedUSE_DUAL_PRIORITY == 1 )
+			/* Once the job has started only tasks above the threshold may preempt it. In
+			 * the lower band the threshold takes effect when the job is promoted. */
+			taskENTER_CRITICAL();
+			pxThisTask->xJobStarted = pdTRUE;
+			if( pdTRUE == pxThisTask->xPromoted && pxThisTask->uxPreemptionThreshold > pxThisTask->uxPriority )
+			{
+				vTaskPrioritySet( NULL, pxThisTask->uxPreemptionThreshold );
+			}
+			taskEXIT_CRITICAL();
+		#elif( schedUSE_PREEMPTION_THRESHOLDS == 1 )
+			/* Once the job has started only tasks above the threshold may preempt it. */
+			if( pxThisTask->uxPreemptionThreshold > pxThisTask->uxPriority )
+			{
+				vTaskPrioritySet( NULL, pxThisTask->uxPreemptionThreshold );
+			}
+		#endif /* schedUSE_PREEMPTION_THRESHOLDS */
+
 		/* Execute the task function specified by the user. */
 		pxThisTask->pvTaskCode( pvParameters );
 
+		#if( schedUSE_SRP == 1 )
+			prvSRPJobEnd( pxThisTask );
+		#endif /* schedUSE_SRP */
+
+		#if( schedUSE_PREEMPTION_THRESHOLDS == 1 )
+			if( pxThisTask->uxPreemptionThreshold > pxThisTask->uxPriority )
+			{
+				vTaskPrioritySet( NULL, pxThisTask->uxPriority );
+			}
+		#endif /* schedUSE_PREEMPTION_THRESHOLDS */
+
+		#if( schedUSE_DUAL_PRIORITY == 1 )
+			/* The next release must not wait behind background work, so the task
+			 * sleeps in the upper band and is lowered by the release itself. */
+			taskENTER_CRITICAL();
+			if( pdFALSE == pxThisTask->xPromoted )
+			{
+				pxThisTask->xPromoted = pdTRUE;
+				vTaskPrioritySet( NULL, pxThisTask->uxPriority );
+			}
+			taskEXIT_CRITICAL();
+		#endif /* schedUSE_DUAL_PRIORITY */
+
+		#if( schedUSE_ELASTIC_TASKS == 1 )
+			prvElasticRecordJob( pxThisTask );
+		#endif /* schedUSE_ELASTIC_TASKS */
+
+		#if( schedUSE_MK_FIRM == 1 )
+			if( pdTRUE == pxThisTask->xIsMKFirm )
+			{
+				taskENTER_CRITICAL();
+				prvMKRecordJob( pxThisTask, pxThisTask->xDeadlineExceeded );
+				pxThisTask->xDeadlineExceeded = pdFALSE;
+				pxThisTask->xMissTolerated = pdFALSE;
+				taskEXIT_CRITICAL();
+			}
+		#endif /* schedUSE_MK_FIRM */
+
 		pxThisTask->xExecTime = 0;   
         
 		/* your implementation goes here: 
@@ -250,12 +853,187 @@ static void prvPeriodicTaskCode( void *pvParameters )
 			2. After each execution, put the current task to sleep until its next activation period using xTaskDelayUntil(). 
 		*/
 		pxThisTask->xWorkIsDone = pdTRUE;
-		xTaskDelayUntil( &pxThisTask->xLastWakeTime, pxThisTask->xPeriod );
+		#if( schedUSE_SPORADIC_TASKS == 1 )
+			if( pdTRUE == pxThisTask->xIsSporadic )
+			{
+				prvWaitForSporadicRelease( pxThisTask );
+				continue;
+			}
+		#endif /* schedUSE_SPORADIC_TASKS */
+		prvWaitForNextRelease( pxThisTask, pxThisTask->xPeriod );
 	}
 }
 
+static void prvWaitForNextRelease( SchedTCB_t *pxThisTask, TickType_t xTimeIncrement )
+{
+	#if( schedUSE_RELEASE_CALENDAR == 1 )
+		TickType_t xRelease = pxThisTask->xLastWakeTime + xTimeIncrement;
+
+		taskENTER_CRITICAL();
+		/* A release that has already passed is served at once, as by xTaskDelayUntil(). */
+		BaseType_t xShouldWait = ( ( TickType_t ) ( xTaskGetTickCount() - pxThisTask->xLastWakeTime ) < xTimeIncrement ) ? pdTRUE : pdFALSE;
+		if( pdTRUE == xShouldWait )
+		{
+			pxThisTask->xNextReleaseTime = xRelease;
+			prvReleaseCalendarInsert( pxThisTask, xTaskGetTickCount() );
+		}
+		taskEXIT_CRITICAL();
+
+		/* The tick hook takes the task out of the calendar before it notifies it, so a
+		 * notification given for another reason does not release a job early. */
+		while( pdTRUE == pxThisTask->xReleaseQueued )
+		{
+			ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		}
+
+		pxThisTask->xLastWakeTime = xRelease;
+
+		TickType_t xJitter = xTaskGetTickCount() - xRelease;
+		if( pdTRUE == xShouldWait && xJitter > pxThisTask->xMaxReleaseJitter )
+		{
+			pxThisTask->xMaxReleaseJitter = xJitter;
+		}
+	#else
+		xTaskDelayUntil( &pxThisTask->xLastWakeTime, xTimeIncrement );
+	#endif /* schedUSE_RELEASE_CALENDAR */
+}
+
+#if( schedUSE_RELEASE_CALENDAR == 1 )
+	static void prvReleaseCalendarInsert( SchedTCB_t *pxTCB, TickType_t xTickCount )
+	{
+		SchedTCB_t **ppxLink = &pxReleaseCalendar;
+
+		/* Every queued release lies ahead of xTickCount, so the distance from it orders
+		 * releases across a tick count overflow. Ties keep their insertion order. */
+		while( NULL != *ppxLink &&
+			( TickType_t ) ( ( *ppxLink )->xNextReleaseTime - xTickCount ) <= ( TickType_t ) ( pxTCB->xNextReleaseTime - xTickCount ) )
+		{
+			ppxLink = &( *ppxLink )->pxNextRelease;
+		}
+
+		pxTCB->pxNextRelease = *ppxLink;
+		*ppxLink = pxTCB;
+		pxTCB->xReleaseQueued = pdTRUE;
+	}
+
+	static void prvReleaseCalendarRemove( SchedTCB_t *pxTCB )
+	{
+		taskENTER_CRITICAL();
+		if( pdTRUE == pxTCB->xReleaseQueued )
+		{
+			SchedTCB_t **ppxLink = &pxReleaseCalendar;
+			while( *ppxLink != pxTCB )
+			{
+				ppxLink = &( *ppxLink )->pxNextRelease;
+			}
+			*ppxLink = pxTCB->pxNextRelease;
+			pxTCB->xReleaseQueued = pdFALSE;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	static void prvReleaseCalendarTick( TickType_t xTickCount )
+	{
+		BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		/* Releases that were due while the scheduler was suspended are served late
+		 * instead of being lost, and show up as release jitter. */
+		while( NULL != pxReleaseCalendar &&
+			( TickType_t ) ( xTickCount - pxReleaseCalendar->xNextReleaseTime ) <= ( portMAX_DELAY >> 1 ) )
+		{
+			SchedTCB_t *pxTCB = pxReleaseCalendar;
+			pxReleaseCalendar = pxTCB->pxNextRelease;
+			pxTCB->xReleaseQueued = pdFALSE;
+			vTaskNotifyGiveFromISR( *pxTCB->pxTaskHandle, &xHigherPriorityTaskWoken );
+		}
+	}
+#endif /* schedUSE_RELEASE_CALENDAR */
+
+#if( schedUSE_SPORADIC_TASKS == 1 )
+	static void prvWaitForSporadicRelease( SchedTCB_t *pxThisTask )
+	{
+		TickType_t xRelease;
+
+		/* The pending flag, not the notification, is the release request, so a request
+		 * made before the task was recreated is not lost. */
+		for( ; ; )
+		{
+			taskENTER_CRITICAL();
+			if( pdTRUE == pxThisTask->xReleasePending )
+			{
+				xRelease = pxThisTask->xPendingReleaseTime;
+				pxThisTask->xReleasePending = pdFALSE;
+				taskEXIT_CRITICAL();
+				break;
+			}
+			taskEXIT_CRITICAL();
+
+			ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		}
+
+		if( pdTRUE == pxThisTask->xReleasedOnce && ( TickType_t ) ( xRelease - pxThisTask->xLastWakeTime ) < pxThisTask->xPeriod )
+		{
+			/* Too close to the previous release, defer to the minimum inter-arrival time. */
+			prvWaitForNextRelease( pxThisTask, pxThisTask->xPeriod );
+		}
+		else
+		{
+			pxThisTask->xLastWakeTime = xRelease;
+		}
+		pxThisTask->xReleasedOnce = pdTRUE;
+	}
+
+	/* Creates a sporadic task. */
+	void vSchedulerSporadicTaskCreate( TaskFunction_t pvTaskCode, const char *pcName, configSTACK_DEPTH_TYPE uxStackDepth, void *pvParameters, UBaseType_t uxPriority,
+			TaskHandle_t *pxCreatedTask, TickType_t xMinInterArrivalTick, TickType_t xMaxExecTimeTick, TickType_t xDeadlineTick )
+	{
+		configASSERT( xMinInterArrivalTick > 0 );
+
+		/* The minimum inter-arrival time stands in for the period in priority assignment and analysis. */
+		vSchedulerPeriodicTaskCreate( pvTaskCode, pcName, uxStackDepth, pvParameters, uxPriority, pxCreatedTask, 0, xMinInterArrivalTick, xMaxExecTimeTick, xDeadlineTick );
+
+		SchedTCB_t *pxTCB = prvGetTCBFromCreatedTask( pxCreatedTask );
+		configASSERT( pxTCB != NULL );
+		pxTCB->xIsSporadic = pdTRUE;
+	}
+
+	/* Releases a job of a sporadic task. Safe to call from an interrupt. */
+	BaseType_t xSchedulerSporadicTaskReleaseFromISR( TaskHandle_t xTaskHandle, BaseType_t *pxHigherPriorityTaskWoken )
+	{
+		SchedTCB_t *pxTCB = NULL;
+		BaseType_t xReturn = pdFAIL;
+
+		configASSERT( xTaskHandle != NULL );
+
+		/* prvGetTCBIndexFromHandle() keeps its search position in a static and may be
+		 * running in the interrupted task, so search the array directly. */
+		for( BaseType_t xIndex = 0; xIndex < schedMAX_NUMBER_OF_PERIODIC_TASKS; xIndex++ )
+		{
+			if( pdTRUE == xTCBArray[ xIndex ].xInUse && *xTCBArray[ xIndex ].pxTaskHandle == xTaskHandle )
+			{
+				pxTCB = &xTCBArray[ xIndex ];
+				break;
+			}
+		}
+		configASSERT( pxTCB != NULL && pdTRUE == pxTCB->xIsSporadic );
+
+		UBaseType_t uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+		if( pdFALSE == pxTCB->xReleasePending )
+		{
+			pxTCB->xPendingReleaseTime = xTaskGetTickCountFromISR();
+			pxTCB->xReleasePending = pdTRUE;
+			xReturn = pdPASS;
+		}
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+		vTaskNotifyGiveFromISR( xTaskHandle, pxHigherPriorityTaskWoken );
+
+		return xReturn;
+	}
+#endif /* schedUSE_SPORADIC_TASKS */
+
 /* Creates a periodic task. */
-void vSchedulerPeriodicTaskCreate( TaskFunction_t pvTaskCode, const char *pcName, UBaseType_t uxStackDepth, void *pvParameters, UBaseType_t uxPriority,
+void vSchedulerPeriodicTaskCreate( TaskFunction_t pvTaskCode, const char *pcName, configSTACK_DEPTH_TYPE uxStackDepth, void *pvParameters, UBaseType_t uxPriority,
 		TaskHandle_t *pxCreatedTask, TickType_t xPhaseTick, TickType_t xPeriodTick, TickType_t xMaxExecTimeTick, TickType_t xDeadlineTick )
 {
 	taskENTER_CRITICAL();
@@ -294,6 +1072,75 @@ void vSchedulerPeriodicTaskCreate( TaskFunction_t pvTaskCode, const char *pcName
 	pxNewTCB->xLastWakeTime = xSystemStartTime;	/* Initializing xLastWakeTime to have a reference value before it is used in xTaskDelayUntil(). */
 	pxNewTCB->xResourceAcquired = pdFALSE;
 
+	#if( schedUSE_PREEMPTION_THRESHOLDS == 1 )
+		pxNewTCB->uxPreemptionThreshold = 0;
+		pxNewTCB->xThresholdIsSet = pdFALSE;
+	#endif /* schedUSE_PREEMPTION_THRESHOLDS */
+
+	#if( schedUSE_CBS == 1 )
+		pxNewTCB->xHasReservation = pdFALSE;
+	#endif /* schedUSE_CBS */
+
+	#if( schedUSE_MIXED_CRITICALITY == 1 )
+		pxNewTCB->xCriticality = schedCRITICALITY_LO;
+		pxNewTCB->xHiMaxExecTime = xMaxExecTimeTick;
+		pxNewTCB->xDropped = pdFALSE;
+		pxNewTCB->xDropPending = pdFALSE;
+	#endif /* schedUSE_MIXED_CRITICALITY */
+
+	#if( schedUSE_MODES == 1 )
+		pxNewTCB->uxModeMask = schedALL_MODES;
+		pxNewTCB->xPhase = xPhaseTick;
+		pxNewTCB->xRetired = pdFALSE;
+		pxNewTCB->xModeReleasePending = pdFALSE;
+	#endif /* schedUSE_MODES */
+
+	#if( schedUSE_TIMING_CHANGES == 1 )
+		pxNewTCB->xTimingChangePending = pdFALSE;
+		pxNewTCB->xPriorityIsStale = pdFALSE;
+	#endif /* schedUSE_TIMING_CHANGES */
+
+	#if( schedUSE_DUAL_PRIORITY == 1 )
+		pxNewTCB->xPromotionOffset = 0;
+		pxNewTCB->xPromoted = pdTRUE;
+		pxNewTCB->xJobStarted = pdFALSE;
+		pxNewTCB->xPromotionDue = pdFALSE;
+	#endif /* schedUSE_DUAL_PRIORITY */
+
+	#if( schedUSE_MK_FIRM == 1 )
+		pxNewTCB->xIsMKFirm = pdFALSE;
+		pxNewTCB->usMissHistory = 0;
+		pxNewTCB->xMissTolerated = pdFALSE;
+		pxNewTCB->uxWindowPosition = 0;
+	#endif /* schedUSE_MK_FIRM */
+
+	#if( schedUSE_ELASTIC_TASKS == 1 )
+		pxNewTCB->uxElasticity = 0;
+		pxNewTCB->ulObservedExecTime = ( uint32_t ) xMaxExecTimeTick << schedELASTIC_EXEC_TIME_SHIFT;
+	#endif /* schedUSE_ELASTIC_TASKS */
+
+	#if( schedUSE_SPORADIC_TASKS == 1 )
+		pxNewTCB->xIsSporadic = pdFALSE;
+		pxNewTCB->xReleasedOnce = pdFALSE;
+		pxNewTCB->xReleasePending = pdFALSE;
+		pxNewTCB->xPendingReleaseTime = 0;
+	#endif /* schedUSE_SPORADIC_TASKS */
+
+	#if( schedUSE_SRP == 1 )
+		pxNewTCB->xSRPJobActive = pdFALSE;
+		pxNewTCB->xSRPWaiting = pdFALSE;
+	#endif /* schedUSE_SRP */
+
+	#if( schedUSE_RELEASE_CALENDAR == 1 )
+		pxNewTCB->pxNextRelease = NULL;
+		pxNewTCB->xReleaseQueued = pdFALSE;
+		pxNewTCB->xMaxReleaseJitter = 0;
+	#endif /* schedUSE_RELEASE_CALENDAR */
+
+	#if( schedUSE_TELEMETRY == 1 )
+		pxNewTCB->uxStackHighWaterMark = uxStackDepth;
+	#endif /* schedUSE_TELEMETRY */
+
 	/* Initialize semaphore related per task information. */
 	for ( BaseType_t xIndex = 0; xIndex < xTaskCounter; xIndex++ ) 
 	{
@@ -303,7 +1150,6 @@ void vSchedulerPeriodicTaskCreate( TaskFunction_t pvTaskCode, const char *pcName
 
 	#if( schedUSE_TCB_ARRAY == 1 )
 		pxNewTCB->xInUse = pdTRUE;
-		pxNewTCB->xPriorityIsSet = pdFALSE;
 	#endif /* schedUSE_TCB_ARRAY */
 	
 	#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 )
@@ -324,110 +1170,1728 @@ void vSchedulerPeriodicTaskCreate( TaskFunction_t pvTaskCode, const char *pcName
 	taskEXIT_CRITICAL();
 }
 
-/* Deletes a periodic task. */
-void vSchedulerPeriodicTaskDelete( TaskHandle_t xTaskHandle )
+/* Returns the extended TCB created with the given pxCreatedTask pointer, or NULL. */
+static SchedTCB_t *prvGetTCBFromCreatedTask( TaskHandle_t *pxCreatedTask )
 {
-	/* your implementation goes here */
-	/* Line 279: 
-		1. Check if xTaskHandle is not NULL by raising an assertion on the condition.
-		2. Obtain the corresponding xTaskHandle index using prvGetTCBIndexFromHandle().
-		3. Using the obtained index, use prvDeleteTCBFromArray() to mark the TCB as unused.
-		4. Decrement xTaskCounter.
-	*/
-	configASSERT( xTaskHandle != NULL );
+	for( BaseType_t xIndex = 0; xIndex < schedMAX_NUMBER_OF_PERIODIC_TASKS; xIndex++ )
+	{
+		if( pdTRUE == xTCBArray[ xIndex ].xInUse && xTCBArray[ xIndex ].pxTaskHandle == pxCreatedTask )
+		{
+			return &xTCBArray[ xIndex ];
+		}
+	}
+	return NULL;
+}
 
-	BaseType_t xIndex = prvGetTCBIndexFromHandle( xTaskHandle );
-	configASSERT( xIndex != -1 );
+#if( schedUSE_PREEMPTION_THRESHOLDS == 1 )
+	/* Sets the preemption threshold of a periodic task. */
+	void vSchedulerPeriodicTaskSetPreemptionThreshold( TaskHandle_t *pxCreatedTask, UBaseType_t uxThreshold )
+	{
+		SchedTCB_t *pxTCB = prvGetTCBFromCreatedTask( pxCreatedTask );
+		configASSERT( pxTCB != NULL );
 
-	prvDeleteTCBFromArray( xIndex );
-	vTaskDelete( xTaskHandle );
-	xTaskCounter--;
-}
+		pxTCB->uxPreemptionThreshold = uxThreshold;
+		pxTCB->xThresholdIsSet = pdTRUE;
+	}
+#endif /* schedUSE_PREEMPTION_THRESHOLDS */
 
-/* Creates all periodic tasks stored in TCB array, or TCB list. */
-static void prvCreateAllTasks( void )
-{
-	SchedTCB_t *pxTCB;
+#if( schedUSE_CBS == 1 )
+	/* Serves a periodic task by a Constant Bandwidth Server. */
+	void vSchedulerPeriodicTaskSetReservation( TaskHandle_t *pxCreatedTask, TickType_t xBudgetTick, TickType_t xServerPeriodTick )
+	{
+		SchedTCB_t *pxTCB = prvGetTCBFromCreatedTask( pxCreatedTask );
+		configASSERT( pxTCB != NULL );
+		configASSERT( xBudgetTick > 0 && xBudgetTick <= xServerPeriodTick );
+
+		pxTCB->xHasReservation = pdTRUE;
+		pxTCB->xMaxExecTime = xBudgetTick;
+		pxTCB->xServerPeriod = xServerPeriodTick;
+		pxTCB->xRemainingBudget = xBudgetTick;
+		pxTCB->xServerDeadline = 0;
+		pxTCB->xIsDemoted = pdFALSE;
+		pxTCB->xPriorityLowered = pdFALSE;
+		pxTCB->xRestorePending = pdFALSE;
+
+		#if( schedUSE_PREEMPTION_THRESHOLDS == 1 )
+			/* A raised threshold would undo the demotion, so soft tasks keep their priority. */
+			pxTCB->uxPreemptionThreshold = 0;
+			pxTCB->xThresholdIsSet = pdTRUE;
+		#endif /* schedUSE_PREEMPTION_THRESHOLDS */
+	}
 
-	#if( schedUSE_TCB_ARRAY == 1 )
-		BaseType_t xIndex;
-		for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+	static void prvReservationRelease( SchedTCB_t *pxTCB )
+	{
+		BaseType_t xRestore = pdFALSE;
+
+		taskENTER_CRITICAL();
 		{
-			configASSERT( pdTRUE == xTCBArray[ xIndex ].xInUse );
-			pxTCB = &xTCBArray[ xIndex ];
-			/* your implementation goes here */
-			/* Line 299: 
-				1. xTaskCreate((TaskFunction_t)prvPeriodicTaskCode, pxTCB->pcName, pxTCB->uxStackDepth, pxTCB->pvParameters, pxTCB->uxPriority, pxTCB->pxTaskHandle)
-			*/
-			BaseType_t xReturnValue = xTaskCreate( (TaskFunction_t)prvPeriodicTaskCode, pxTCB->pcName, pxTCB->uxStackDepth, pxTCB->pvParameters, pxTCB->uxPriority, pxTCB->pxTaskHandle );
-			configASSERT( xReturnValue != errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY )
-		}	
-	#endif /* schedUSE_TCB_ARRAY */
-}
+			/* Keep the current server deadline only if the remaining budget does not
+			 * exceed the bandwidth left until it: c >= ( d - r ) * Q / T starts afresh. */
+			TickType_t xLeft = pxTCB->xServerDeadline - pxTCB->xLastWakeTime;
+			if( xLeft > ( portMAX_DELAY >> 1 ) ||
+				( uint32_t ) pxTCB->xRemainingBudget * pxTCB->xServerPeriod >= ( uint32_t ) xLeft * pxTCB->xMaxExecTime )
+			{
+				pxTCB->xServerDeadline = pxTCB->xLastWakeTime + pxTCB->xServerPeriod;
+				pxTCB->xRemainingBudget = pxTCB->xMaxExecTime;
+				xRestore = pxTCB->xPriorityLowered;
+				pxTCB->xIsDemoted = pdFALSE;
+				pxTCB->xPriorityLowered = pdFALSE;
+				pxTCB->xRestorePending = pdFALSE;
+			}
+		}
+		taskEXIT_CRITICAL();
 
-#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_RMS || schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_DMS )
-	/* Initiazes fixed priorities of all periodic tasks with respect to RMS policy. */
-	static void prvSetFixedPriorities( void )
+		if( pdTRUE == xRestore )
+		{
+			vTaskPrioritySet( NULL, pxTCB->uxPriority );
+		}
+	}
+
+	static void prvReservationCharge( SchedTCB_t *pxTCB )
 	{
-		BaseType_t xIter, xIndex;
-		TickType_t xShortest, xPreviousShortest = 0;
-		SchedTCB_t *pxShortestTaskPointer, *pxTCB;
+		/* Work done in the background while demoted is not charged. */
+		if( pdTRUE == pxTCB->xIsDemoted )
+		{
+			return;
+		}
 
-		#if( schedUSE_SCHEDULER_TASK == 1 )
-			BaseType_t xHighestPriority = schedSCHEDULER_PRIORITY; 
-		#else
-			BaseType_t xHighestPriority = configMAX_PRIORITIES;
-		#endif /* schedUSE_SCHEDULER_TASK */
+		pxTCB->xRemainingBudget--;
+		if( 0 == pxTCB->xRemainingBudget )
+		{
+			/* Postpone the deadline and recharge. Until the old deadline the task may
+			 * only use time no other task wants. */
+			pxTCB->xServerDeadline += pxTCB->xServerPeriod;
+			pxTCB->xRemainingBudget = pxTCB->xMaxExecTime;
+			pxTCB->xIsDemoted = pdTRUE;
+			prvWakeScheduler();
+		}
+	}
 
-		for( xIter = 0; xIter < xTaskCounter; xIter++ )
+	static void prvReservationUpdatePriorities( void )
+	{
+		for( BaseType_t xIndex = 0; xIndex < xTaskCounter; xIndex++ )
 		{
-			xShortest = portMAX_DELAY;
+			SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+			UBaseType_t uxNewPriority;
 
-			/* search for shortest period */
-			for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+			if( pdFALSE == pxTCB->xHasReservation )
 			{
-				/* your implementation goes here: 
-					1. Iterate through xTCBArray and find the next shortest priority.
-				*/
-				pxTCB = &xTCBArray[xIndex];
-				configASSERT( pxTCB->xInUse == pdTRUE );
-
-				if ( pxTCB->xPriorityIsSet == pdFALSE )
-				{
-					#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_RMS )
-						if ( pxTCB->xPeriod <= xShortest )
-						{
-							xShortest = pxTCB->xPeriod;
-							pxShortestTaskPointer = pxTCB;
-						}
-					#elif( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_DMS )
-						if ( pxTCB->xRelativeDeadline <= xShortest )
-						{
-							xShortest = pxTCB->xRelativeDeadline;
-							pxShortestTaskPointer = pxTCB;
-						}
-					#endif /* schedSCHEDULING_POLICY */
-				}
+				continue;
 			}
-		
-			/* set highest priority to task with xShortest period (the highest priority is configMAX_PRIORITIES - 1) */
-			/* your implementation goes here: 
-				1. Assign the priority according to the period.
-				2. Assign the next shortest priority found to xPreviousShortest. This will help in the next iteration.
-			*/
-			pxShortestTaskPointer->uxPriority = xHighestPriority;
-			pxShortestTaskPointer->xPriorityIsSet = pdTRUE;
 
-			if( xPreviousShortest != xShortest )
+			taskENTER_CRITICAL();
+			if( pdTRUE == pxTCB->xRestorePending )
 			{
-				xHighestPriority--;
+				uxNewPriority = pxTCB->uxPriority;
+				pxTCB->xIsDemoted = pdFALSE;
+				pxTCB->xPriorityLowered = pdFALSE;
+				pxTCB->xRestorePending = pdFALSE;
 			}
-		
+			else if( pdTRUE == pxTCB->xIsDemoted && pdFALSE == pxTCB->xPriorityLowered )
+			{
+				uxNewPriority = tskIDLE_PRIORITY;
+				pxTCB->xPriorityLowered = pdTRUE;
+			}
+			else
+			{
+				taskEXIT_CRITICAL();
+				continue;
+			}
+			taskEXIT_CRITICAL();
+
+			vTaskPrioritySet( *pxTCB->pxTaskHandle, uxNewPriority );
+		}
+	}
+#endif /* schedUSE_CBS */
+
+#if( schedUSE_RESOURCE_DECLARATIONS == 1 )
+	/* Records that a periodic task uses a resource. */
+	void vSchedulerPeriodicTaskDeclareResource( TaskHandle_t *pxCreatedTask, SemaphoreHandle_t xSemaphore )
+	{
+		SchedTCB_t *pxTCB = prvGetTCBFromCreatedTask( pxCreatedTask );
+		configASSERT( pxTCB != NULL );
+		configASSERT( xSemaphore != NULL );
+
+		SchedResource_t *pxResource = prvGetResource( xSemaphore );
+		if( NULL == pxResource )
+		{
+			configASSERT( xResourceCounter < schedMAX_NUMBER_OF_RESOURCES );
+			pxResource = &xResourceArray[ xResourceCounter ];
+			xResourceCounter++;
+			pxResource->xSemaphore = xSemaphore;
+			pxResource->ulUsers = 0;
+		}
+
+		pxResource->ulUsers |= 1UL << ( pxTCB - xTCBArray );
+	}
+
+	static SchedResource_t *prvGetResource( SemaphoreHandle_t xSemaphore )
+	{
+		for( BaseType_t xIndex = 0; xIndex < xResourceCounter; xIndex++ )
+		{
+			if( xResourceArray[ xIndex ].xSemaphore == xSemaphore )
+			{
+				return &xResourceArray[ xIndex ];
+			}
+		}
+		return NULL;
+	}
+
+	static void prvSetResourceCeilings( void )
+	{
+		for( BaseType_t xResource = 0; xResource < xResourceCounter; xResource++ )
+		{
+			SchedResource_t *pxResource = &xResourceArray[ xResource ];
+			UBaseType_t *puxCeiling = &xAssignment.uxCeiling[ xResource ];
+			BaseType_t xIndex;
+
+			#if( schedUSE_SRP == 0 )
+				/* Priority ceiling protocol: the ceiling is the highest priority among the users. */
+				*puxCeiling = tskIDLE_PRIORITY;
+				for( xIndex = 0; xIndex < schedMAX_NUMBER_OF_PERIODIC_TASKS; xIndex++ )
+				{
+					if( pdTRUE == xTCBArray[ xIndex ].xInUse && ( pxResource->ulUsers & ( 1UL << xIndex ) ) &&
+						xAssignment.uxPriority[ xIndex ] > *puxCeiling )
+					{
+						*puxCeiling = xAssignment.uxPriority[ xIndex ];
+					}
+				}
+				continue;
+			#endif /* schedUSE_SRP */
+
+			TickType_t *pxCeilingLevel = &xAssignment.xCeilingLevel[ xResource ];
+			*pxCeilingLevel = portMAX_DELAY;
+			for( xIndex = 0; xIndex < schedMAX_NUMBER_OF_PERIODIC_TASKS; xIndex++ )
+			{
+				if( pdTRUE == xTCBArray[ xIndex ].xInUse && ( pxResource->ulUsers & ( 1UL << xIndex ) ) &&
+					xTCBArray[ xIndex ].xRelativeDeadline < *pxCeilingLevel )
+				{
+					*pxCeilingLevel = xTCBArray[ xIndex ].xRelativeDeadline;
+				}
+			}
+
+			/* A job whose preemption level does not exceed the ceiling must not start while
+			 * the resource is held, so the holder runs above all such tasks. Under DMS this
+			 * is the priority of the highest priority user. */
+			*puxCeiling = tskIDLE_PRIORITY;
+			for( xIndex = 0; xIndex < schedMAX_NUMBER_OF_PERIODIC_TASKS; xIndex++ )
+			{
+				if( pdTRUE == xTCBArray[ xIndex ].xInUse && xTCBArray[ xIndex ].xRelativeDeadline >= *pxCeilingLevel &&
+					xAssignment.uxPriority[ xIndex ] > *puxCeiling )
+				{
+					*puxCeiling = xAssignment.uxPriority[ xIndex ];
+				}
+			}
+		}
+	}
+
+	static UBaseType_t prvGetResourceCeilingOfTask( SchedTCB_t *pxTCB )
+	{
+		BaseType_t xTask = pxTCB - xTCBArray;
+		UBaseType_t uxCeiling = xAssignment.uxPriority[ xTask ];
+		uint32_t ulMask = 1UL << xTask;
+
+		for( BaseType_t xIndex = 0; xIndex < xResourceCounter; xIndex++ )
+		{
+			if( ( xResourceArray[ xIndex ].ulUsers & ulMask ) && xAssignment.uxCeiling[ xIndex ] > uxCeiling )
+			{
+				uxCeiling = xAssignment.uxCeiling[ xIndex ];
+			}
+		}
+		return uxCeiling;
+	}
+#endif /* schedUSE_RESOURCE_DECLARATIONS */
+
+#if( schedUSE_SRP == 1 )
+	static BaseType_t prvSRPIsUser( SchedTCB_t *pxTCB )
+	{
+		uint32_t ulMask = 1UL << ( pxTCB - xTCBArray );
+
+		for( BaseType_t xIndex = 0; xIndex < xResourceCounter; xIndex++ )
+		{
+			if( xResourceArray[ xIndex ].ulUsers & ulMask )
+			{
+				return pdTRUE;
+			}
+		}
+		return pdFALSE;
+	}
+
+	static BaseType_t prvSRPMayStart( SchedTCB_t *pxTCB )
+	{
+		BaseType_t xIndex;
+
+		/* Raising the holder to the ceiling does not keep out a task of the same priority,
+		 * as FreeRTOS time slices and preempts on equal priorities. A job holds nothing
+		 * before it starts, so every held resource is held by another task. The count of
+		 * the mutex changes together with the take, leaving no window in between. */
+		for( xIndex = 0; xIndex < xResourceCounter; xIndex++ )
+		{
+			if( 0 == uxSemaphoreGetCount( xResourceArray[ xIndex ].xSemaphore ) &&
+				pxTCB->xRelativeDeadline >= xResourceArray[ xIndex ].xCeilingLevel )
+			{
+				return pdFALSE;
+			}
+		}
+
+		/* A job only preempts a started job of a lower preemption level. */
+		for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+		{
+			SchedTCB_t *pxOther = &xTCBArray[ xIndex ];
+			if( pxOther != pxTCB && pdTRUE == pxOther->xSRPJobActive && pxTCB->xRelativeDeadline >= pxOther->xRelativeDeadline )
+			{
+				return pdFALSE;
+			}
+		}
+		return pdTRUE;
+	}
+
+	static void prvSRPWaitForStart( SchedTCB_t *pxThisTask )
+	{
+		if( pdFALSE == prvSRPIsUser( pxThisTask ) )
+		{
+			return;
+		}
+
+		/* The start rule, not the notification, ends the wait, as in prvWaitForNextRelease(). */
+		for( ; ; )
+		{
+			taskENTER_CRITICAL();
+			if( pdTRUE == prvSRPMayStart( pxThisTask ) )
+			{
+				pxThisTask->xSRPWaiting = pdFALSE;
+				pxThisTask->xSRPJobActive = pdTRUE;
+				taskEXIT_CRITICAL();
+				break;
+			}
+			pxThisTask->xSRPWaiting = pdTRUE;
+			taskEXIT_CRITICAL();
+
+			ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		}
+	}
+
+	static void prvSRPJobEnd( SchedTCB_t *pxTCB )
+	{
+		taskENTER_CRITICAL();
+		pxTCB->xSRPWaiting = pdFALSE;
+		if( pdTRUE == pxTCB->xSRPJobActive )
+		{
+			pxTCB->xSRPJobActive = pdFALSE;
+			prvSRPWakeWaiters();
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	static void prvSRPWakeWaiters( void )
+	{
+		for( BaseType_t xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+		{
+			if( pdTRUE == xTCBArray[ xIndex ].xSRPWaiting )
+			{
+				xTaskNotifyGive( *xTCBArray[ xIndex ].pxTaskHandle );
+			}
+		}
+	}
+
+	static UBaseType_t prvSRPHolderPriority( SchedTCB_t *pxThisTask )
+	{
+		UBaseType_t uxPriority = pxThisTask->uxSRPBasePriority;
+
+		for( BaseType_t xSlot = 0; xSlot < MAX_SEMAPHORES_PER_TASK; xSlot++ )
+		{
+			SchedResource_t *pxResource = ( NULL == pxThisTask->xAcquiredSemaphores[ xSlot ] ) ? NULL : prvGetResource( pxThisTask->xAcquiredSemaphores[ xSlot ] );
+			if( NULL != pxResource && pxResource->uxCeiling > uxPriority )
+			{
+				uxPriority = pxResource->uxCeiling;
+			}
+		}
+		return uxPriority;
+	}
+#endif /* schedUSE_SRP */
+
+#if( schedUSE_MIXED_CRITICALITY == 1 )
+	/* Sets the criticality of a periodic task. */
+	void vSchedulerPeriodicTaskSetCriticality( TaskHandle_t *pxCreatedTask, BaseType_t xCriticality, TickType_t xHiMaxExecTimeTick )
+	{
+		SchedTCB_t *pxTCB = prvGetTCBFromCreatedTask( pxCreatedTask );
+		configASSERT( pxTCB != NULL );
+		configASSERT( xHiMaxExecTimeTick >= pxTCB->xMaxExecTime );
+
+		pxTCB->xCriticality = xCriticality;
+		pxTCB->xHiMaxExecTime = xHiMaxExecTimeTick;
+	}
+
+	/* Returns the criticality the system runs at. */
+	BaseType_t xSchedulerGetCriticality( void )
+	{
+		return xSystemCriticality;
+	}
+
+	static TickType_t prvGetMaxExecTime( SchedTCB_t *pxTCB, BaseType_t xCriticality )
+	{
+		return ( schedCRITICALITY_HI == xCriticality && schedCRITICALITY_HI == pxTCB->xCriticality ) ? pxTCB->xHiMaxExecTime : pxTCB->xMaxExecTime;
+	}
+
+	static void prvCriticalityUpdate( void )
+	{
+		BaseType_t xIndex;
+
+		if( pdTRUE == xCriticalityRaised )
+		{
+			xCriticalityRaised = pdFALSE;
+			#if( schedUSE_DEBUG_PRINTS == 1 )
+				Serial.println( "Criticality: HI" );
+			#endif /* schedUSE_DEBUG_PRINTS */
+
+			/* LO jobs are abandoned so that HI tasks can use their HI budgets. */
+			for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+			{
+				SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+				if( schedCRITICALITY_LO == pxTCB->xCriticality && pdFALSE == pxTCB->xDropped )
+				{
+					pxTCB->xDropPending = pdTRUE;
+				}
+			}
+		}
+
+		if( pdTRUE == xCriticalityLowered )
+		{
+			xCriticalityLowered = pdFALSE;
+			xSystemCriticality = schedCRITICALITY_LO;
+			#if( schedUSE_DEBUG_PRINTS == 1 )
+				Serial.println( "Criticality: LO" );
+			#endif /* schedUSE_DEBUG_PRINTS */
+
+			TickType_t xNow = xTaskGetTickCount();
+			for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+			{
+				SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+
+				/* A job that still held a resource was never dropped and just carries on. */
+				pxTCB->xDropPending = pdFALSE;
+				if( pdFALSE == pxTCB->xDropped )
+				{
+					continue;
+				}
+				pxTCB->xDropped = pdFALSE;
+
+				/* A fresh instance is released at the next period boundary of the task's
+				 * original release pattern. */
+				TickType_t xMissed = ( TickType_t ) ( xNow - pxTCB->xLastWakeTime ) / pxTCB->xPeriod + 1;
+				TickType_t xNextRelease = pxTCB->xLastWakeTime + xMissed * pxTCB->xPeriod;
+				prvDeleteAndRecreateTask( pxTCB );
+				pxTCB->xReleaseTime = xNextRelease - xSystemStartTime;
+				pxTCB->xAbsoluteDeadline = xNextRelease + pxTCB->xRelativeDeadline;
+			}
+		}
+
+		if( schedCRITICALITY_HI != xSystemCriticality )
+		{
+			return;
+		}
+
+		for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+		{
+			SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+			if( pdFALSE == pxTCB->xDropPending )
+			{
+				continue;
+			}
+
+			#if( schedUSE_MODES == 1 )
+				/* Tasks retired by a mode change stay with the mode change protocol. */
+				if( pdTRUE == pxTCB->xRetired )
+				{
+					pxTCB->xDropPending = pdFALSE;
+					continue;
+				}
+			#endif /* schedUSE_MODES */
+
+			/* As for timing errors, a job is only abandoned once it holds no resource. A
+			 * suspended holder would keep the resource at its ceiling, and HI tasks that
+			 * need it would wait until LO mode returns. xTaskResourceGive() wakes the
+			 * scheduler task when the last resource of such a job is given back. */
+			taskENTER_CRITICAL();
+			if( pxTCB->xWorkIsDone == pdTRUE || pxTCB->xResourceAcquired == pdFALSE )
+			{
+				pxTCB->xDropPending = pdFALSE;
+				pxTCB->xDropped = pdTRUE;
+				vTaskSuspend( *pxTCB->pxTaskHandle );
+				#if( schedUSE_SRP == 1 )
+					/* The abandoned job no longer keeps jobs of the same level from starting. */
+					prvSRPJobEnd( pxTCB );
+				#endif /* schedUSE_SRP */
+			}
+			taskEXIT_CRITICAL();
+		}
+	}
+#endif /* schedUSE_MIXED_CRITICALITY */
+
+#if( schedUSE_MODES == 1 )
+	/* Creates a mode. */
+	BaseType_t xSchedulerModeCreate( const char *pcName )
+	{
+		configASSERT( xModeCounter < schedMAX_NUMBER_OF_MODES );
+
+		pcModeNames[ xModeCounter ] = pcName;
+		xModeCounter++;
+		return xModeCounter - 1;
+	}
+
+	/* Sets the modes a periodic task belongs to. */
+	void vSchedulerPeriodicTaskSetModes( TaskHandle_t *pxCreatedTask, UBaseType_t uxModeMask )
+	{
+		SchedTCB_t *pxTCB = prvGetTCBFromCreatedTask( pxCreatedTask );
+		configASSERT( pxTCB != NULL );
+
+		pxTCB->uxModeMask = uxModeMask;
+	}
+
+	/* Requests a mode change. */
+	BaseType_t xSchedulerModeChange( BaseType_t xMode )
+	{
+		configASSERT( xMode >= 0 && xMode < xModeCounter );
+
+		if( NULL == xSchedulerHandle )
+		{
+			/* Not started yet: this selects the initial mode. */
+			xCurrentMode = xMode;
+			xTargetMode = xMode;
+			return pdPASS;
+		}
+
+		taskENTER_CRITICAL();
+		if( eModeStable != eModeChangeState || xMode == xCurrentMode )
+		{
+			taskEXIT_CRITICAL();
+			return pdFAIL;
+		}
+		xTargetMode = xMode;
+		eModeChangeState = eModeRetiring;
+		taskEXIT_CRITICAL();
+
+		xTaskNotifyGive( xSchedulerHandle );
+		return pdPASS;
+	}
+
+	/* Returns the current mode. */
+	BaseType_t xSchedulerGetMode( void )
+	{
+		return xCurrentMode;
+	}
+
+	/* Returns the name of a mode. */
+	const char *pcSchedulerGetModeName( BaseType_t xMode )
+	{
+		configASSERT( xMode >= 0 && xMode < xModeCounter );
+		return pcModeNames[ xMode ];
+	}
+
+	static BaseType_t prvIsTaskInMode( SchedTCB_t *pxTCB, BaseType_t xMode )
+	{
+		return ( 0 != ( pxTCB->uxModeMask & ( ( UBaseType_t ) 1 << xMode ) ) ) ? pdTRUE : pdFALSE;
+	}
+
+	static void prvModeChangeRelease( SchedTCB_t *pxThisTask )
+	{
+		if( eModeRetiring == eModeChangeState && pdFALSE == prvIsTaskInMode( pxThisTask, xTargetMode ) )
+		{
+			/* A release is a job boundary, so the task holds no resource and no stack
+			 * space of a job. It is resumed when a mode containing it is entered. */
+			pxThisTask->xRetired = pdTRUE;
+			xTaskNotifyGive( xSchedulerHandle );
+			vTaskSuspend( NULL );
+
+			#if( schedUSE_SPORADIC_TASKS == 1 )
+				if( pdTRUE == pxThisTask->xIsSporadic )
+				{
+					/* The release that retired the task is not served in the new mode. */
+					prvWaitForSporadicRelease( pxThisTask );
+				}
+			#endif /* schedUSE_SPORADIC_TASKS */
+		}
+
+		if( pdTRUE == pxThisTask->xModeReleasePending )
+		{
+			pxThisTask->xModeReleasePending = pdFALSE;
+			pxThisTask->xLastWakeTime = pxThisTask->xModeReleaseTime;
+			if( pxThisTask->xPhase > 0 )
+			{
+				prvWaitForNextRelease( pxThisTask, pxThisTask->xPhase );
+			}
+		}
+	}
+
+	static void prvModeChangeUpdate( void )
+	{
+		BaseType_t xIndex;
+
+		if( eModeRetiring == eModeChangeState )
+		{
+			for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+			{
+				SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+
+				#if( schedUSE_MIXED_CRITICALITY == 1 )
+					if( pdFALSE == prvIsTaskInMode( pxTCB, xTargetMode ) && pdTRUE == pxTCB->xDropped )
+					{
+						/* A dropped job never reaches the release at which it would retire.
+						 * It holds no resource and is abandoned anyway, so a fresh instance
+						 * is retired in its place, like a task outside the initial mode. */
+						prvDeleteAndRecreateTask( pxTCB );
+						vTaskSuspend( *pxTCB->pxTaskHandle );
+						pxTCB->xDropped = pdFALSE;
+						pxTCB->xRetired = pdTRUE;
+					}
+				#endif /* schedUSE_MIXED_CRITICALITY */
+
+				if( pdFALSE == prvIsTaskInMode( pxTCB, xTargetMode ) && pdFALSE == pxTCB->xRetired )
+				{
+					return;
+				}
+			}
+			/* The tick hook moves on at the next idle instant. */
+			eModeChangeState = eModeWaitingForIdle;
+		}
+
+		if( eModeReleaseDue != eModeChangeState )
+		{
+			return;
+		}
+
+		TickType_t xNow = xTaskGetTickCount();
+		for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+		{
+			SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+			if( pdFALSE == pxTCB->xRetired || pdFALSE == prvIsTaskInMode( pxTCB, xTargetMode ) )
+			{
+				continue;
+			}
+
+			pxTCB->xRetired = pdFALSE;
+			#if( schedUSE_SPORADIC_TASKS == 1 )
+				if( pdTRUE == pxTCB->xIsSporadic )
+				{
+					/* Interrupts seen while retired do not release a job. */
+					pxTCB->xReleasePending = pdFALSE;
+				}
+				else
+			#endif /* schedUSE_SPORADIC_TASKS */
+			{
+				pxTCB->xModeReleaseTime = xNow;
+				pxTCB->xModeReleasePending = pdTRUE;
+			}
+			vTaskResume( *pxTCB->pxTaskHandle );
+		}
+
+		xCurrentMode = xTargetMode;
+		eModeChangeState = eModeStable;
+		#if( schedUSE_DEBUG_PRINTS == 1 )
+			Serial.print( "Mode: " );
+			Serial.println( pcModeNames[ xCurrentMode ] );
+		#endif /* schedUSE_DEBUG_PRINTS */
+	}
+
+	static void prvSuspendTasksOutsideMode( void )
+	{
+		for( BaseType_t xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+		{
+			SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+			if( pdFALSE == prvIsTaskInMode( pxTCB, xCurrentMode ) )
+			{
+				pxTCB->xRetired = pdTRUE;
+				vTaskSuspend( *pxTCB->pxTaskHandle );
+			}
+		}
+	}
+#endif /* schedUSE_MODES */
+
+#if( schedUSE_TIMING_CHANGES == 1 )
+	/* Changes the timing parameters of a periodic task at its next release. */
+	BaseType_t xSchedulerPeriodicTaskSetTiming( TaskHandle_t xTaskHandle, TickType_t xPeriodTick, TickType_t xDeadlineTick, TickType_t xMaxExecTimeTick )
+	{
+		configASSERT( xTaskHandle != NULL );
+
+		BaseType_t xIndex = prvGetTCBIndexFromHandle( xTaskHandle );
+		configASSERT( xIndex != -1 );
+		SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+
+		/* Invalid parameters are refused here instead of at the release that would use
+		 * them. A job whose WCET exceeds its deadline can never meet it, and run-time
+		 * changes are limited to deadlines within the period. */
+		if( 0 == xPeriodTick || xDeadlineTick > xPeriodTick || xMaxExecTimeTick > xDeadlineTick )
+		{
+			return pdFAIL;
+		}
+
+		taskENTER_CRITICAL();
+		pxTCB->xPendingPeriod = xPeriodTick;
+		pxTCB->xPendingRelativeDeadline = xDeadlineTick;
+		pxTCB->xPendingMaxExecTime = xMaxExecTimeTick;
+		pxTCB->xTimingChangePending = pdTRUE;
+		taskEXIT_CRITICAL();
+
+		return pdPASS;
+	}
+
+	static void prvApplyTimingChange( SchedTCB_t *pxThisTask )
+	{
+		taskENTER_CRITICAL();
+		pxThisTask->xPeriod = pxThisTask->xPendingPeriod;
+		pxThisTask->xRelativeDeadline = pxThisTask->xPendingRelativeDeadline;
+		pxThisTask->xMaxExecTime = pxThisTask->xPendingMaxExecTime;
+		pxThisTask->xTimingChangePending = pdFALSE;
+		taskEXIT_CRITICAL();
+
+		/* The analysis runs in the scheduler task at schedSCHEDULER_PRIORITY, so every
+		 * periodic task below that priority waits for it like for any other scheduler
+		 * task pass, and the task that shares the priority is time sliced with it. */
+		xReassignmentPending = pdTRUE;
+		xTaskNotifyGive( xSchedulerHandle );
+		taskYIELD();
+	}
+
+	static void prvReassignPriorities( void )
+	{
+		BaseType_t xIndex;
+
+		/* The analysis works on xAssignment only, so tasks that run meanwhile still see
+		 * the complete old assignment. */
+		( void ) prvAssignPriorities();
+
+		/* The new assignment is published and handed to the kernel in one step. */
+		vTaskSuspendAll();
+		prvPublishAssignment();
+		for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+		{
+			SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+			UBaseType_t uxNewPriority = pxTCB->uxPriority;
+
+			if( NULL == *pxTCB->pxTaskHandle )
+			{
+				continue;
+			}
+
+			#if( schedUSE_DUAL_PRIORITY == 1 )
+				/* Jobs in the lower band are promoted early, which is always safe. */
+				pxTCB->xPromoted = pdTRUE;
+			#endif /* schedUSE_DUAL_PRIORITY */
+
+			#if( schedUSE_CBS == 1 )
+				/* A demoted soft task gets its new priority when it is restored. */
+				if( pdTRUE == pxTCB->xPriorityLowered )
+				{
+					continue;
+				}
+			#endif /* schedUSE_CBS */
+
+			#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 && configUSE_MUTEXES == 1 )
+				/* The priority of a resource holder is managed by the resource protocol until
+				 * the resource is given back, so it is updated at its next release. */
+				if( pxTCB->xSemaphoreCount > 0 )
+				{
+					pxTCB->xPriorityIsStale = pdTRUE;
+					continue;
+				}
+			#endif
+
+			#if( schedUSE_PREEMPTION_THRESHOLDS == 1 )
+				if( pdFALSE == pxTCB->xWorkIsDone && pxTCB->uxPreemptionThreshold > pxTCB->uxPriority )
+				{
+					uxNewPriority = pxTCB->uxPreemptionThreshold;
+				}
+			#endif /* schedUSE_PREEMPTION_THRESHOLDS */
+
+			if( uxTaskPriorityGet( *pxTCB->pxTaskHandle ) != uxNewPriority )
+			{
+				vTaskPrioritySet( *pxTCB->pxTaskHandle, uxNewPriority );
+			}
+		}
+		( void ) xTaskResumeAll();
+	}
+#endif /* schedUSE_TIMING_CHANGES */
+
+#if( schedUSE_DUAL_PRIORITY == 1 )
+	static void prvDualPrioritySetOffsets( void )
+	{
+		for( BaseType_t xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+		{
+			SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+			uint32_t ulResponseTime = prvResponseTime( pxTCB );
+
+			xAssignment.xPromotionOffset[ xIndex ] = 0;
+
+			#if( schedUSE_CBS == 1 )
+				/* Soft tasks are bounded by their server instead. */
+				if( pdTRUE == pxTCB->xHasReservation )
+				{
+					continue;
+				}
+			#endif /* schedUSE_CBS */
+
+			#if( schedUSE_SPORADIC_SERVER == 1 )
+				if( pxTCB == xSporadicServer.pxTCB )
+				{
+					continue;
+				}
+			#endif /* schedUSE_SPORADIC_SERVER */
+
+			/* Lower band jobs cannot delay upper band jobs, so the response time in the
+			 * upper band is the usual fixed-priority response time. */
+			if( ulResponseTime < pxTCB->xRelativeDeadline )
+			{
+				/* Background work must stay below every upper band priority. */
+				configASSERT( xAssignment.uxPriority[ xIndex ] > schedDUAL_PRIORITY_BACKGROUND_PRIORITY );
+				xAssignment.xPromotionOffset[ xIndex ] = ( TickType_t ) ( pxTCB->xRelativeDeadline - ulResponseTime );
+			}
+		}
+	}
+
+	static void prvDualPriorityUpdate( void )
+	{
+		for( BaseType_t xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+		{
+			SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+			if( pdFALSE == pxTCB->xPromotionDue )
+			{
+				continue;
+			}
+
+			taskENTER_CRITICAL();
+			pxTCB->xPromotionDue = pdFALSE;
+			if( pdFALSE == pxTCB->xPromoted && pdFALSE == pxTCB->xWorkIsDone )
+			{
+				UBaseType_t uxNewPriority = pxTCB->uxPriority;
+				pxTCB->xPromoted = pdTRUE;
+
+				#if( schedUSE_PREEMPTION_THRESHOLDS == 1 )
+					/* A job that has not run yet must not block others through its threshold. */
+					if( pdTRUE == pxTCB->xJobStarted && pxTCB->uxPreemptionThreshold > uxNewPriority )
+					{
+						uxNewPriority = pxTCB->uxPreemptionThreshold;
+					}
+				#endif /* schedUSE_PREEMPTION_THRESHOLDS */
+
+				#if( schedUSE_SRP == 1 )
+					/* A resource holder runs at the ceiling already and must come back to
+					 * the upper band, not the lower one, when it gives the resource back. */
+					if( pxTCB->xSemaphoreCount > 0 && pxTCB->uxSRPBasePriority < uxNewPriority )
+					{
+						pxTCB->uxSRPBasePriority = uxNewPriority;
+					}
+				#endif /* schedUSE_SRP */
+
+				if( uxTaskPriorityGet( *pxTCB->pxTaskHandle ) < uxNewPriority )
+				{
+					vTaskPrioritySet( *pxTCB->pxTaskHandle, uxNewPriority );
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+	}
+#endif /* schedUSE_DUAL_PRIORITY */
+
+#if( schedUSE_MK_FIRM == 1 )
+	/* Makes a periodic task (m,k)-firm. */
+	void vSchedulerPeriodicTaskSetMKFirm( TaskHandle_t *pxCreatedTask, UBaseType_t uxMaxMisses, UBaseType_t uxWindow )
+	{
+		SchedTCB_t *pxTCB = prvGetTCBFromCreatedTask( pxCreatedTask );
+		configASSERT( pxTCB != NULL );
+		configASSERT( uxWindow > 0 && uxWindow <= 16 && uxMaxMisses < uxWindow );
+		#if( schedUSE_SPORADIC_TASKS == 1 )
+			configASSERT( pdFALSE == pxTCB->xIsSporadic );
+		#endif /* schedUSE_SPORADIC_TASKS */
+
+		pxTCB->xIsMKFirm = pdTRUE;
+		pxTCB->uxMaxMisses = uxMaxMisses;
+		pxTCB->uxWindow = uxWindow;
+	}
+
+	static UBaseType_t prvMKRecentMisses( SchedTCB_t *pxTCB )
+	{
+		uint16_t usHistory = pxTCB->usMissHistory & ( uint16_t ) ( ( 1UL << ( pxTCB->uxWindow - 1 ) ) - 1 );
+		UBaseType_t uxMisses = 0;
+
+		while( 0 != usHistory )
+		{
+			usHistory &= ( uint16_t ) ( usHistory - 1 );
+			uxMisses++;
+		}
+		return uxMisses;
+	}
+
+	static void prvMKRecordJob( SchedTCB_t *pxTCB, BaseType_t xMissed )
+	{
+		pxTCB->usMissHistory = ( uint16_t ) ( pxTCB->usMissHistory << 1 ) | ( ( pdTRUE == xMissed ) ? 1U : 0U );
+	}
+
+	static BaseType_t prvMKShouldSkipJob( SchedTCB_t *pxThisTask )
+	{
+		UBaseType_t uxPosition = pxThisTask->uxWindowPosition;
+
+		pxThisTask->uxWindowPosition = ( uxPosition + 1 == pxThisTask->uxWindow ) ? 0 : uxPosition + 1;
+
+		/* Deeply-red pattern: the first k - m jobs of a window are mandatory. */
+		if( uxPosition < pxThisTask->uxWindow - pxThisTask->uxMaxMisses )
+		{
+			return pdFALSE;
+		}
+
+		/* An optional job is skipped only while the task itself is behind, i.e. its
+		 * previous job missed or was skipped, so the skips of an overload run to the
+		 * end of the window and the next window starts with mandatory jobs. */
+		if( 0 == ( pxThisTask->usMissHistory & 1U ) )
+		{
+			return pdFALSE;
+		}
+
+		return ( prvMKRecentMisses( pxThisTask ) < pxThisTask->uxMaxMisses ) ? pdTRUE : pdFALSE;
+	}
+#endif /* schedUSE_MK_FIRM */
+
+#if( schedUSE_ELASTIC_TASKS == 1 )
+	/* Makes a periodic task elastic. */
+	void vSchedulerPeriodicTaskSetElastic( TaskHandle_t *pxCreatedTask, UBaseType_t uxElasticity, TickType_t xMinPeriodTick, TickType_t xMaxPeriodTick )
+	{
+		SchedTCB_t *pxTCB = prvGetTCBFromCreatedTask( pxCreatedTask );
+		configASSERT( pxTCB != NULL );
+		configASSERT( xMinPeriodTick > 0 && xMinPeriodTick <= xMaxPeriodTick );
+		#if( schedUSE_SPORADIC_TASKS == 1 )
+			configASSERT( pdFALSE == pxTCB->xIsSporadic );
+		#endif /* schedUSE_SPORADIC_TASKS */
+
+		pxTCB->uxElasticity = uxElasticity;
+		pxTCB->xMinPeriod = xMinPeriodTick;
+		pxTCB->xMaxPeriod = xMaxPeriodTick;
+		pxTCB->xElasticPeriod = xMinPeriodTick;
+		/* The deadline keeps its ratio to the period, so a task with D = T keeps D = T. */
+		pxTCB->xNominalDeadline = ( TickType_t ) ( ( ( uint32_t ) pxTCB->xRelativeDeadline * xMinPeriodTick ) / pxTCB->xPeriod );
+		pxTCB->xPeriod = xMinPeriodTick;
+		pxTCB->xRelativeDeadline = pxTCB->xNominalDeadline;
+	}
+
+	static void prvElasticRecordJob( SchedTCB_t *pxThisTask )
+	{
+		uint32_t ulExecTime = ( uint32_t ) pxThisTask->xExecTime << schedELASTIC_EXEC_TIME_SHIFT;
+
+		/* A 32-bit access takes several instructions on AVR, and the scheduler task must
+		 * not see half of an update. */
+		taskENTER_CRITICAL();
+		uint32_t ulObserved = pxThisTask->ulObservedExecTime;
+
+		/* Follow an increase at once and a decrease slowly, so that a single short
+		 * job does not relax the periods. */
+		if( ulExecTime >= ulObserved )
+		{
+			ulObserved = ulExecTime;
+		}
+		else
+		{
+			ulObserved -= ( ulObserved - ulExecTime ) >> 3;
+		}
+		pxThisTask->ulObservedExecTime = ulObserved;
+		taskEXIT_CRITICAL();
+	}
+
+	static uint32_t prvElasticUtilisation( uint32_t ulObservedExecTime, TickType_t xPeriod )
+	{
+		return ( ulObservedExecTime << ( 10 - schedELASTIC_EXEC_TIME_SHIFT ) ) / xPeriod;
+	}
+
+	/* Buttazzo's elastic model: the utilisation above schedELASTIC_UTILISATION_BOUND
+	 * is taken from the elastic tasks in proportion to their elasticity. A task that
+	 * would drop below the utilisation at its maximum period is held there and the
+	 * rest is shared again among the others. */
+	static void prvElasticUpdate( void )
+	{
+		BaseType_t xSaturated[ schedMAX_NUMBER_OF_PERIODIC_TASKS ] = { pdFALSE };
+		/* Only the scheduler task runs this, so the 32-bit arrays are kept off its stack. */
+		static uint32_t ulTarget[ schedMAX_NUMBER_OF_PERIODIC_TASKS ];
+		static uint32_t ulObserved[ schedMAX_NUMBER_OF_PERIODIC_TASKS ];
+		uint32_t ulFixed, ulNominal, ulElasticity, ulLoad = 0;
+		BaseType_t xIndex, xAgain;
+
+		for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+		{
+			SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+
+			taskENTER_CRITICAL();
+			ulObserved[ xIndex ] = pxTCB->ulObservedExecTime;
+			taskEXIT_CRITICAL();
+
+			ulLoad += prvElasticUtilisation( ulObserved[ xIndex ], ( 0 == pxTCB->uxElasticity ) ? pxTCB->xPeriod : pxTCB->xMinPeriod );
+		}
+
+		/* Every change of period costs a priority reassignment, so the periods are only
+		 * computed again once the observed load has moved noticeably. */
+		if( UINT32_MAX != ulElasticLastLoad &&
+			( ( ulLoad > ulElasticLastLoad ) ? ulLoad - ulElasticLastLoad : ulElasticLastLoad - ulLoad ) < schedELASTIC_LOAD_HYSTERESIS )
+		{
+			return;
+		}
+		ulElasticLastLoad = ulLoad;
+
+		do
+		{
+			xAgain = pdFALSE;
+			ulFixed = 0;
+			ulNominal = 0;
+			ulElasticity = 0;
+			for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+			{
+				SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+				if( 0 == pxTCB->uxElasticity )
+				{
+					ulFixed += prvElasticUtilisation( ulObserved[ xIndex ], pxTCB->xPeriod );
+				}
+				else if( pdTRUE == xSaturated[ xIndex ] )
+				{
+					ulFixed += prvElasticUtilisation( ulObserved[ xIndex ], pxTCB->xMaxPeriod );
+				}
+				else
+				{
+					ulNominal += prvElasticUtilisation( ulObserved[ xIndex ], pxTCB->xMinPeriod );
+					ulElasticity += pxTCB->uxElasticity;
+				}
+			}
+
+			uint32_t ulExcess = 0;
+			if( ulFixed + ulNominal > schedELASTIC_UTILISATION_BOUND )
+			{
+				ulExcess = ulFixed + ulNominal - schedELASTIC_UTILISATION_BOUND;
+			}
+
+			for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+			{
+				SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+				if( 0 == pxTCB->uxElasticity || pdTRUE == xSaturated[ xIndex ] )
+				{
+					continue;
+				}
+
+				uint32_t ulShare = ( ulExcess * pxTCB->uxElasticity ) / ulElasticity;
+				uint32_t ulNominalTask = prvElasticUtilisation( ulObserved[ xIndex ], pxTCB->xMinPeriod );
+				uint32_t ulMinimum = prvElasticUtilisation( ulObserved[ xIndex ], pxTCB->xMaxPeriod );
+				if( ulShare > ulNominalTask - ulMinimum || ( ulShare > 0 && ulShare == ulNominalTask ) )
+				{
+					xSaturated[ xIndex ] = pdTRUE;
+					xAgain = pdTRUE;
+				}
+				else
+				{
+					ulTarget[ xIndex ] = ulNominalTask - ulShare;
+				}
+			}
+		} while( pdTRUE == xAgain );
+
+		for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+		{
+			SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+			TickType_t xNewPeriod;
+
+			if( 0 == pxTCB->uxElasticity )
+			{
+				continue;
+			}
+
+			if( pdTRUE == xSaturated[ xIndex ] )
+			{
+				xNewPeriod = pxTCB->xMaxPeriod;
+			}
+			else if( 0 == ulTarget[ xIndex ] )
+			{
+				/* The observed execution time is below the resolution of the model. */
+				xNewPeriod = pxTCB->xMinPeriod;
+			}
+			else
+			{
+				uint32_t ulPeriod = ( ( ulObserved[ xIndex ] << ( 10 - schedELASTIC_EXEC_TIME_SHIFT ) ) + ulTarget[ xIndex ] - 1 ) / ulTarget[ xIndex ];
+				xNewPeriod = ( ulPeriod < pxTCB->xMinPeriod ) ? pxTCB->xMinPeriod : ( ulPeriod > pxTCB->xMaxPeriod ) ? pxTCB->xMaxPeriod : ( TickType_t ) ulPeriod;
+			}
+
+			/* Stretch at once, but relax only by more than a tick or back to the minimum
+			 * period, so that rounding does not move the period back and forth. */
+			if( xNewPeriod > pxTCB->xElasticPeriod ||
+				( xNewPeriod < pxTCB->xElasticPeriod && ( xNewPeriod + 1 < pxTCB->xElasticPeriod || xNewPeriod == pxTCB->xMinPeriod ) ) )
+			{
+				if( pdPASS == xSchedulerPeriodicTaskSetTiming( *pxTCB->pxTaskHandle, xNewPeriod,
+					( TickType_t ) ( ( ( uint32_t ) pxTCB->xNominalDeadline * xNewPeriod ) / pxTCB->xMinPeriod ), pxTCB->xMaxExecTime ) )
+				{
+					pxTCB->xElasticPeriod = xNewPeriod;
+				}
+			}
+		}
+	}
+#endif /* schedUSE_ELASTIC_TASKS */
+
+/* Deletes a periodic task. */
+void vSchedulerPeriodicTaskDelete( TaskHandle_t xTaskHandle )
+{
+	/* your implementation goes here */
+	/* Line 279: 
+		1. Check if xTaskHandle is not NULL by raising an assertion on the condition.
+		2. Obtain the corresponding xTaskHandle index using prvGetTCBIndexFromHandle().
+		3. Using the obtained index, use prvDeleteTCBFromArray() to mark the TCB as unused.
+		4. Decrement xTaskCounter.
+	*/
+	configASSERT( xTaskHandle != NULL );
+
+	BaseType_t xIndex = prvGetTCBIndexFromHandle( xTaskHandle );
+	configASSERT( xIndex != -1 );
+
+	#if( schedUSE_RELEASE_CALENDAR == 1 )
+		prvReleaseCalendarRemove( &xTCBArray[ xIndex ] );
+	#endif /* schedUSE_RELEASE_CALENDAR */
+
+	prvDeleteTCBFromArray( xIndex );
+	vTaskDelete( xTaskHandle );
+	xTaskCounter--;
+}
+
+/* Creates all periodic tasks stored in TCB array, or TCB list. */
+static void prvCreateAllTasks( void )
+{
+	SchedTCB_t *pxTCB;
+
+	#if( schedUSE_TCB_ARRAY == 1 )
+		BaseType_t xIndex;
+		for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+		{
+			configASSERT( pdTRUE == xTCBArray[ xIndex ].xInUse );
+			pxTCB = &xTCBArray[ xIndex ];
+			/* your implementation goes here */
+			/* Line 299: 
+				1. xTaskCreate((TaskFunction_t)prvPeriodicTaskCode, pxTCB->pcName, pxTCB->uxStackDepth, pxTCB->pvParameters, pxTCB->uxPriority, pxTCB->pxTaskHandle)
+			*/
+			BaseType_t xReturnValue = xTaskCreate( (TaskFunction_t)prvPeriodicTaskCode, pxTCB->pcName, pxTCB->uxStackDepth, pxTCB->pvParameters, pxTCB->uxPriority, pxTCB->pxTaskHandle );
+			configASSERT( xReturnValue != errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY )
+		}	
+	#endif /* schedUSE_TCB_ARRAY */
+}
+
+#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_RMS || schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_DMS )
+	/* Initiazes fixed priorities of all periodic tasks with respect to RMS policy. */
+	static void prvSetFixedPriorities( void )
+	{
+		BaseType_t xIter, xIndex;
+		TickType_t xShortest, xPreviousShortest = 0;
+		SchedTCB_t *pxShortestTaskPointer, *pxTCB;
+
+		#if( schedUSE_SCHEDULER_TASK == 1 )
+			BaseType_t xHighestPriority = schedSCHEDULER_PRIORITY; 
+		#else
+			BaseType_t xHighestPriority = configMAX_PRIORITIES;
+		#endif /* schedUSE_SCHEDULER_TASK */
+
+		for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+		{
+			xAssignment.xPriorityIsSet[ xIndex ] = pdFALSE;
+		}
+
+		for( xIter = 0; xIter < xTaskCounter; xIter++ )
+		{
+			xShortest = portMAX_DELAY;
+
+			/* search for shortest period */
+			for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+			{
+				/* your implementation goes here: 
+					1. Iterate through xTCBArray and find the next shortest priority.
+				*/
+				pxTCB = &xTCBArray[xIndex];
+				configASSERT( pxTCB->xInUse == pdTRUE );
+
+				if ( xAssignment.xPriorityIsSet[ xIndex ] == pdFALSE )
+				{
+					#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_RMS )
+						if ( pxTCB->xPeriod <= xShortest )
+						{
+							xShortest = pxTCB->xPeriod;
+							pxShortestTaskPointer = pxTCB;
+						}
+					#elif( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_DMS )
+						if ( pxTCB->xRelativeDeadline <= xShortest )
+						{
+							xShortest = pxTCB->xRelativeDeadline;
+							pxShortestTaskPointer = pxTCB;
+						}
+					#endif /* schedSCHEDULING_POLICY */
+				}
+			}
+		
+			/* set highest priority to task with xShortest period (the highest priority is configMAX_PRIORITIES - 1) */
+			/* your implementation goes here: 
+				1. Assign the priority according to the period.
+				2. Assign the next shortest priority found to xPreviousShortest. This will help in the next iteration.
+			*/
+			xAssignment.uxPriority[ pxShortestTaskPointer - xTCBArray ] = xHighestPriority;
+			xAssignment.xPriorityIsSet[ pxShortestTaskPointer - xTCBArray ] = pdTRUE;
+
+			if( xPreviousShortest != xShortest )
+			{
+				xHighestPriority--;
+			}
+		
 			xPreviousShortest = xShortest;
 		}
 	}
+
+	static BaseType_t prvAssignPriorities( void )
+	{
+		BaseType_t xOptimal = pdFALSE;
+
+		#if( schedUSE_PREEMPTION_THRESHOLDS == 1 )
+			/* Thresholds given by the user are kept as they are. */
+			for( BaseType_t xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+			{
+				xAssignment.uxPreemptionThreshold[ xIndex ] = xTCBArray[ xIndex ].uxPreemptionThreshold;
+			}
+		#endif /* schedUSE_PREEMPTION_THRESHOLDS */
+
+		prvSetFixedPriorities();
+
+		#if( schedUSE_RESOURCE_DECLARATIONS == 1 )
+			prvSetResourceCeilings();
+		#endif /* schedUSE_RESOURCE_DECLARATIONS */
+
+		#if( schedUSE_PREEMPTION_THRESHOLDS == 1 && schedAUTO_ASSIGN_PREEMPTION_THRESHOLDS == 1 )
+			/* The old thresholds belong to the old priorities. */
+			prvClearPreemptionThresholds();
+		#endif /* schedUSE_PREEMPTION_THRESHOLDS */
+
+		#if( schedUSE_OPTIMAL_PRIORITY_ASSIGNMENT == 1 )
+			if( pdFALSE == prvIsTaskSetSchedulable( pdFALSE ) )
+			{
+				xOptimal = prvAssignOptimalPriorities();
+			}
+		#endif /* schedUSE_OPTIMAL_PRIORITY_ASSIGNMENT */
+
+		#if( schedUSE_PREEMPTION_THRESHOLDS == 1 && schedAUTO_ASSIGN_PREEMPTION_THRESHOLDS == 1 )
+			prvAssignPreemptionThresholds();
+		#endif /* schedUSE_PREEMPTION_THRESHOLDS */
+
+		#if( schedUSE_DUAL_PRIORITY == 1 )
+			prvDualPrioritySetOffsets();
+		#endif /* schedUSE_DUAL_PRIORITY */
+
+		return xOptimal;
+	}
+
+	static void prvPublishAssignment( void )
+	{
+		BaseType_t xIndex;
+
+		for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+		{
+			SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+
+			pxTCB->uxPriority = xAssignment.uxPriority[ xIndex ];
+			#if( schedUSE_PREEMPTION_THRESHOLDS == 1 )
+				pxTCB->uxPreemptionThreshold = xAssignment.uxPreemptionThreshold[ xIndex ];
+			#endif /* schedUSE_PREEMPTION_THRESHOLDS */
+			#if( schedUSE_DUAL_PRIORITY == 1 )
+				pxTCB->xPromotionOffset = xAssignment.xPromotionOffset[ xIndex ];
+			#endif /* schedUSE_DUAL_PRIORITY */
+		}
+
+		#if( schedUSE_RESOURCE_DECLARATIONS == 1 )
+			for( xIndex = 0; xIndex < xResourceCounter; xIndex++ )
+			{
+				SchedResource_t *pxResource = &xResourceArray[ xIndex ];
+
+				pxResource->uxCeiling = xAssignment.uxCeiling[ xIndex ];
+				#if( schedUSE_SRP == 1 )
+					pxResource->xCeilingLevel = xAssignment.xCeilingLevel[ xIndex ];
+				#else
+					vInitializePriorityCeiling( pxResource->xSemaphore, pxResource->uxCeiling );
+				#endif /* schedUSE_SRP */
+			}
+		#endif /* schedUSE_RESOURCE_DECLARATIONS */
+	}
 #endif /* schedSCHEDULING_POLICY */
 
+#if( schedUSE_RESPONSE_TIME_ANALYSIS == 1 )
+	/* Worst-case response time of pxTask, following the analysis of Wang and Saksena for
+	 * preemption thresholds. It covers deadlines longer than the period by checking every
+	 * job in the level-i busy period, and reduces to plain fixed-priority analysis when
+	 * every threshold equals its priority. Tasks of equal priority are assumed to
+	 * interfere with each other, as time slicing is enabled. For the same reason a task
+	 * whose priority equals the threshold of a started job still preempts it. */
+	static uint32_t prvResponseTime( SchedTCB_t *pxTask )
+	{
+		BaseType_t xTask = pxTask - xTCBArray;
+		UBaseType_t uxPriority = xAssignment.uxPriority[ xTask ];
+		uint32_t ulBlocking = 0;
+
+		for( BaseType_t xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+		{
+			SchedTCB_t *pxOther = &xTCBArray[ xIndex ];
+
+			/* A lower priority job that has already started below its threshold blocks. */
+			if( xAssignment.uxPriority[ xIndex ] < uxPriority && prvGetBlockingLevel( pxOther ) >= uxPriority && pxOther->xMaxExecTime > ulBlocking )
+			{
+				ulBlocking = pxOther->xMaxExecTime;
+			}
+		}
+
+		#if( schedUSE_PERIODIC_JOBS == 1 )
+			if( pxTask->pxTaskHandle == &xJobDispatcherHandle )
+			{
+				return prvJobDispatcherResponseTime( xTask, ulBlocking );
+			}
+		#endif /* schedUSE_PERIODIC_JOBS */
+
+		return prvResponseTimeOf( xTask, pxTask->xMaxExecTime, pxTask->xPeriod, ulBlocking, 0 );
+	}
+
+	static uint32_t prvResponseTimeOf( BaseType_t xTask, uint32_t ulExecTime, uint32_t ulPeriod, uint32_t ulBlocking, BaseType_t xJobsAbove )
+	{
+		UBaseType_t uxPriority = xAssignment.uxPriority[ xTask ];
+		#if( schedUSE_PREEMPTION_THRESHOLDS == 1 )
+			UBaseType_t uxThreshold = prvGetPreemptionThreshold( &xTCBArray[ xTask ] );
+		#else
+			UBaseType_t uxThreshold = uxPriority;
+		#endif /* schedUSE_PREEMPTION_THRESHOLDS */
+		/* Utilisation of the level-i tasks in 1/1024, rounded up. */
+		uint32_t ulUtilisation = ( ulExecTime * 1024UL + ulPeriod - 1 ) / ulPeriod, ulResponseTime = 0;
+		BaseType_t xIndex;
+
+		#if( schedUSE_PERIODIC_JOBS == 1 )
+			ulUtilisation += prvJobUtilisation( xJobsAbove );
+		#endif /* schedUSE_PERIODIC_JOBS */
+		for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+		{
+			if( xIndex != xTask && xAssignment.uxPriority[ xIndex ] >= uxPriority )
+			{
+				ulUtilisation += prvUtilisation( xIndex );
+			}
+		}
+
+		if( ulUtilisation > 1024UL )
+		{
+			return UINT32_MAX;
+		}
+
+		/* Length of the level-i busy period. */
+		uint32_t ulBusyPeriod = ulBlocking + ulExecTime, ulNext;
+		for( ; ; )
+		{
+			ulNext = ulBlocking + ( ( ulBusyPeriod + ulPeriod - 1 ) / ulPeriod ) * ulExecTime;
+			#if( schedUSE_PERIODIC_JOBS == 1 )
+				ulNext += prvJobDemand( xJobsAbove, ulBusyPeriod, pdFALSE );
+			#endif /* schedUSE_PERIODIC_JOBS */
+			for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+			{
+				if( xIndex != xTask && xAssignment.uxPriority[ xIndex ] >= uxPriority )
+				{
+					ulNext += prvDemand( xIndex, ulBusyPeriod, pdFALSE );
+				}
+			}
+
+			if( ulNext == ulBusyPeriod )
+			{
+				break;
+			}
+			if( ulNext > ulPeriod * RTA_MAX_JOBS_PER_BUSY_PERIOD )
+			{
+				return UINT32_MAX;
+			}
+			ulBusyPeriod = ulNext;
+		}
+
+		uint32_t ulJobs = ( ulBusyPeriod + ulPeriod - 1 ) / ulPeriod;
+		for( uint32_t ulJob = 0; ulJob < ulJobs; ulJob++ )
+		{
+			/* Latest start time of job ulJob: all higher and equal priority releases up to
+			 * and including the start time are served first. */
+			uint32_t ulStart = ulBlocking + ulJob * ulExecTime;
+			for( ; ; )
+			{
+				ulNext = ulBlocking + ulJob * ulExecTime;
+				#if( schedUSE_PERIODIC_JOBS == 1 )
+					ulNext += prvJobDemand( xJobsAbove, ulStart, pdTRUE );
+				#endif /* schedUSE_PERIODIC_JOBS */
+				for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+				{
+					if( xIndex != xTask && xAssignment.uxPriority[ xIndex ] >= uxPriority )
+					{
+						ulNext += prvDemand( xIndex, ulStart, pdTRUE );
+					}
+				}
+
+				if( ulNext == ulStart )
+				{
+					break;
+				}
+				ulStart = ulNext;
+			}
+
+			/* Finish time: after the start only tasks above the threshold preempt. */
+			uint32_t ulFinish = ulStart + ulExecTime;
+			for( ; ; )
+			{
+				ulNext = ulStart + ulExecTime;
+				for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+				{
+					if( xIndex != xTask && xAssignment.uxPriority[ xIndex ] >= uxThreshold )
+					{
+						ulNext += prvDemand( xIndex, ulFinish, pdFALSE ) - prvDemand( xIndex, ulStart, pdTRUE );
+					}
+				}
+
+				if( ulNext == ulFinish )
+				{
+					break;
+				}
+				ulFinish = ulNext;
+			}
+
+			if( ulFinish - ulJob * ulPeriod > ulResponseTime )
+			{
+				ulResponseTime = ulFinish - ulJob * ulPeriod;
+			}
+		}
+
+		return ulResponseTime;
+	}
+
+	static uint32_t prvDemand( BaseType_t xIndex, uint32_t ulTime, BaseType_t xClosed )
+	{
+		SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+
+		#if( schedUSE_PERIODIC_JOBS == 1 )
+			/* The dispatcher is charged for the jobs it runs, not for each of its releases. */
+			if( pxTCB->pxTaskHandle == &xJobDispatcherHandle )
+			{
+				return prvJobDemand( xJobCounter, ulTime, xClosed );
+			}
+		#endif /* schedUSE_PERIODIC_JOBS */
+
+		uint32_t ulReleases = ( pdTRUE == xClosed ) ? ulTime / pxTCB->xPeriod + 1 : ( ulTime + pxTCB->xPeriod - 1 ) / pxTCB->xPeriod;
+		return ulReleases * pxTCB->xMaxExecTime;
+	}
+
+	static uint32_t prvUtilisation( BaseType_t xIndex )
+	{
+		SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+
+		#if( schedUSE_PERIODIC_JOBS == 1 )
+			if( pxTCB->pxTaskHandle == &xJobDispatcherHandle )
+			{
+				return prvJobUtilisation( xJobCounter );
+			}
+		#endif /* schedUSE_PERIODIC_JOBS */
+
+		return ( ( uint32_t ) pxTCB->xMaxExecTime * 1024UL + pxTCB->xPeriod - 1 ) / pxTCB->xPeriod;
+	}
+
+	static UBaseType_t prvGetBlockingLevel( SchedTCB_t *pxTCB )
+	{
+		#if( schedUSE_PREEMPTION_THRESHOLDS == 1 )
+			UBaseType_t uxLevel = prvGetPreemptionThreshold( pxTCB );
+		#else
+			UBaseType_t uxLevel = xAssignment.uxPriority[ pxTCB - xTCBArray ];
+		#endif /* schedUSE_PREEMPTION_THRESHOLDS */
+
+		#if( schedUSE_RESOURCE_DECLARATIONS == 1 )
+			/* Critical section lengths are not known, so a lower priority job that can
+			 * hold a resource with a ceiling at or above a priority blocks for its WCET. */
+			UBaseType_t uxCeiling = prvGetResourceCeilingOfTask( pxTCB );
+			if( uxCeiling > uxLevel )
+			{
+				uxLevel = uxCeiling;
+			}
+		#endif /* schedUSE_RESOURCE_DECLARATIONS */
+
+		return uxLevel;
+	}
+
+	#if( schedUSE_MIXED_CRITICALITY == 1 )
+		/* AMC-rtb response time of a HI task after a switch to HI mode: HI tasks interfere
+		 * with their HI budget over the whole response time, LO tasks with their LO budget
+		 * only up to the LO mode response time. Assumes deadlines not longer than periods. */
+		static uint32_t prvResponseTimeHI( SchedTCB_t *pxTask )
+		{
+			uint32_t ulLoResponseTime = prvResponseTime( pxTask );
+			uint32_t ulBlocking = 0, ulResponseTime, ulNext;
+			BaseType_t xIndex, xTask = pxTask - xTCBArray;
+			UBaseType_t uxPriority = xAssignment.uxPriority[ xTask ];
+
+			if( UINT32_MAX == ulLoResponseTime )
+			{
+				return UINT32_MAX;
+			}
+
+			for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+			{
+				SchedTCB_t *pxOther = &xTCBArray[ xIndex ];
+				if( xAssignment.uxPriority[ xIndex ] < uxPriority && prvGetBlockingLevel( pxOther ) >= uxPriority && prvGetMaxExecTime( pxOther, schedCRITICALITY_HI ) > ulBlocking )
+				{
+					ulBlocking = prvGetMaxExecTime( pxOther, schedCRITICALITY_HI );
+				}
+			}
+
+			ulResponseTime = ulBlocking + pxTask->xHiMaxExecTime;
+			for( ; ; )
+			{
+				ulNext = ulBlocking + pxTask->xHiMaxExecTime;
+				for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+				{
+					SchedTCB_t *pxOther = &xTCBArray[ xIndex ];
+					if( xIndex == xTask || xAssignment.uxPriority[ xIndex ] < uxPriority )
+					{
+						continue;
+					}
+
+					if( schedCRITICALITY_HI == pxOther->xCriticality )
+					{
+						ulNext += ( ( ulResponseTime + pxOther->xPeriod - 1 ) / pxOther->xPeriod ) * pxOther->xHiMaxExecTime;
+					}
+					else
+					{
+						ulNext += prvDemand( xIndex, ulLoResponseTime, pdFALSE );
+					}
+				}
+
+				if( ulNext == ulResponseTime )
+				{
+					return ulResponseTime;
+				}
+				if( ulNext > pxTask->xRelativeDeadline )
+				{
+					return UINT32_MAX;
+				}
+				ulResponseTime = ulNext;
+			}
+		}
+	#endif /* schedUSE_MIXED_CRITICALITY */
+
+	/* Returns pdTRUE if every periodic task meets its deadline. */
+	static BaseType_t prvIsTaskSetSchedulable( BaseType_t xReport )
+	{
+		BaseType_t xSchedulable = pdTRUE;
+
+		for( BaseType_t xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+		{
+			SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+			uint32_t ulResponseTime = prvResponseTime( pxTCB );
+
+			if( ulResponseTime > pxTCB->xRelativeDeadline )
+			{
+				xSchedulable = pdFALSE;
+			}
+
+			#if( schedUSE_MIXED_CRITICALITY == 1 )
+				uint32_t ulHiResponseTime = 0;
+				if( schedCRITICALITY_HI == pxTCB->xCriticality )
+				{
+					ulHiResponseTime = prvResponseTimeHI( pxTCB );
+					if( ulHiResponseTime > pxTCB->xRelativeDeadline )
+					{
+						xSchedulable = pdFALSE;
+					}
+				}
+			#endif /* schedUSE_MIXED_CRITICALITY */
+
+			if( pdTRUE == xReport )
+			{
+				Serial.print( pxTCB->pcName );
+				Serial.print( ": R=" );
+				if( UINT32_MAX == ulResponseTime )
+				{
+					Serial.print( "inf" );
+				}
+				else
+				{
+					Serial.print( ulResponseTime );
+				}
+				#if( schedUSE_MIXED_CRITICALITY == 1 )
+					if( schedCRITICALITY_HI == pxTCB->xCriticality )
+					{
+						Serial.print( " R(HI)=" );
+						if( UINT32_MAX == ulHiResponseTime )
+						{
+							Serial.print( "inf" );
+						}
+						else
+						{
+							Serial.print( ulHiResponseTime );
+						}
+					}
+				#endif /* schedUSE_MIXED_CRITICALITY */
+				Serial.print( " D=" );
+				Serial.println( pxTCB->xRelativeDeadline );
+			}
+			else if( pdFALSE == xSchedulable )
+			{
+				break;
+			}
+		}
+
+		return xSchedulable;
+	}
+
+	#if( schedUSE_OPTIMAL_PRIORITY_ASSIGNMENT == 1 )
+		/* Audsley's algorithm: going from the lowest priority up, each level is given to
+		 * any unassigned task that meets its deadline there while all other unassigned
+		 * tasks are above it. The response time of a task does not depend on the order of
+		 * the tasks above it, so a schedulable order is found whenever one exists. This
+		 * holds while every threshold equals its task's priority, so prvAssignPriorities()
+		 * clears the automatic thresholds first and assigns them again afterwards; a
+		 * user-given threshold is kept as it is and may make the search miss an order. */
+		static BaseType_t prvAssignOptimalPriorities( void )
+		{
+			UBaseType_t uxSavedPriorities[ schedMAX_NUMBER_OF_PERIODIC_TASKS ];
+			#if( schedUSE_SCHEDULER_TASK == 1 )
+				UBaseType_t uxHighestPriority = schedSCHEDULER_PRIORITY;
+			#else
+				UBaseType_t uxHighestPriority = configMAX_PRIORITIES - 1;
+			#endif /* schedUSE_SCHEDULER_TASK */
+			BaseType_t xIndex, xCandidate;
+
+			/* Every task needs a level of its own above the idle task. */
+			configASSERT( ( UBaseType_t ) xTaskCounter <= uxHighestPriority );
+
+			for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+			{
+				uxSavedPriorities[ xIndex ] = xAssignment.uxPriority[ xIndex ];
+				xAssignment.xPriorityIsSet[ xIndex ] = pdFALSE;
+			}
+
+			for( UBaseType_t uxLevel = uxHighestPriority + 1 - xTaskCounter; uxLevel <= uxHighestPriority; uxLevel++ )
+			{
+				BaseType_t xTried[ schedMAX_NUMBER_OF_PERIODIC_TASKS ] = { pdFALSE };
+				BaseType_t xFound = pdFALSE;
+
+				/* Trying the RMS/DMS order from its lowest priority first keeps the
+				 * result close to it. */
+				for( ; ; )
+				{
+					xCandidate = -1;
+					for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+					{
+						if( pdFALSE == xAssignment.xPriorityIsSet[ xIndex ] && pdFALSE == xTried[ xIndex ] &&
+							( -1 == xCandidate || uxSavedPriorities[ xIndex ] < uxSavedPriorities[ xCandidate ] ) )
+						{
+							xCandidate = xIndex;
+						}
+					}
+					if( -1 == xCandidate )
+					{
+						break;
+					}
+
+					for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+					{
+						if( pdFALSE == xAssignment.xPriorityIsSet[ xIndex ] )
+						{
+							xAssignment.uxPriority[ xIndex ] = ( xIndex == xCandidate ) ? uxLevel : uxLevel + 1;
+						}
+					}
+					#if( schedUSE_RESOURCE_DECLARATIONS == 1 )
+						prvSetResourceCeilings();
+					#endif /* schedUSE_RESOURCE_DECLARATIONS */
+
+					if( prvResponseTime( &xTCBArray[ xCandidate ] ) <= xTCBArray[ xCandidate ].xRelativeDeadline )
+					{
+						xAssignment.xPriorityIsSet[ xCandidate ] = pdTRUE;
+						xFound = pdTRUE;
+						break;
+					}
+					xTried[ xCandidate ] = pdTRUE;
+				}
+
+				if( pdFALSE == xFound )
+				{
+					for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+					{
+						xAssignment.uxPriority[ xIndex ] = uxSavedPriorities[ xIndex ];
+						xAssignment.xPriorityIsSet[ xIndex ] = pdTRUE;
+					}
+					#if( schedUSE_RESOURCE_DECLARATIONS == 1 )
+						prvSetResourceCeilings();
+					#endif /* schedUSE_RESOURCE_DECLARATIONS */
+					return pdFALSE;
+				}
+			}
+
+			return pdTRUE;
+		}
+	#endif /* schedUSE_OPTIMAL_PRIORITY_ASSIGNMENT */
+#endif /* schedUSE_RESPONSE_TIME_ANALYSIS */
+
+#if( schedUSE_PREEMPTION_THRESHOLDS == 1 )
+	/* Returns the effective preemption threshold of a task. */
+	static UBaseType_t prvGetPreemptionThreshold( SchedTCB_t *pxTCB )
+	{
+		BaseType_t xTask = pxTCB - xTCBArray;
+		return ( xAssignment.uxPreemptionThreshold[ xTask ] > xAssignment.uxPriority[ xTask ] ) ? xAssignment.uxPreemptionThreshold[ xTask ] : xAssignment.uxPriority[ xTask ];
+	}
+
+	#if( schedAUTO_ASSIGN_PREEMPTION_THRESHOLDS == 1 )
+		/* A threshold of 0 makes prvGetPreemptionThreshold() follow the priority, which
+		 * also holds while prvAssignOptimalPriorities() moves the priorities around. */
+		static void prvClearPreemptionThresholds( void )
+		{
+			for( BaseType_t xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+			{
+				if( pdFALSE == xTCBArray[ xIndex ].xThresholdIsSet )
+				{
+					xAssignment.uxPreemptionThreshold[ xIndex ] = 0;
+				}
+			}
+		}
+
+		/* Greedy maximal threshold assignment: going from the highest to the lowest
+		 * priority, each task's threshold is raised one level at a time for as long as
+		 * the whole task set stays schedulable. Higher thresholds mean fewer preemptions
+		 * and larger groups of tasks that never preempt each other. */
+		static void prvAssignPreemptionThresholds( void )
+		{
+			UBaseType_t uxHighestPriority = 0;
+			BaseType_t xIndex;
+
+			prvClearPreemptionThresholds();
+			for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+			{
+				if( xAssignment.uxPriority[ xIndex ] > uxHighestPriority )
+				{
+					uxHighestPriority = xAssignment.uxPriority[ xIndex ];
+				}
+			}
+
+			/* Thresholds cannot repair a set that is unschedulable to begin with. */
+			if( pdFALSE == prvIsTaskSetSchedulable( pdFALSE ) )
+			{
+				return;
+			}
+
+			for( UBaseType_t uxLevel = uxHighestPriority + 1; uxLevel-- > 0; )
+			{
+				for( xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+				{
+					UBaseType_t *puxThreshold = &xAssignment.uxPreemptionThreshold[ xIndex ];
+					if( xAssignment.uxPriority[ xIndex ] != uxLevel || pdTRUE == xTCBArray[ xIndex ].xThresholdIsSet )
+					{
+						continue;
+					}
+
+					while( *puxThreshold < uxHighestPriority )
+					{
+						( *puxThreshold )++;
+						if( pdFALSE == prvIsTaskSetSchedulable( pdFALSE ) )
+						{
+							( *puxThreshold )--;
+							break;
+						}
+					}
+				}
+			}
+		}
+	#endif /* schedAUTO_ASSIGN_PREEMPTION_THRESHOLDS */
+#endif /* schedUSE_PREEMPTION_THRESHOLDS */
+
 /* Called when a deadline of a periodic task is missed.
  * Deletes the periodic task that has missed it's deadline and recreate it.
  * The periodic task is released during next period. */
@@ -437,9 +2901,33 @@ static void prvDeleteAndRecreateTask( SchedTCB_t *pxTCB )
 	/* your implementation goes here:
 		1. vTaskDelete(*pxTCB->pxTaskHandle)
 	*/
+	#if( schedUSE_TELEMETRY == 1 )
+		/* The stack usage of this instance is lost once it is deleted. */
+		prvUpdateStackHighWaterMark( pxTCB );
+	#endif /* schedUSE_TELEMETRY */
+
+	#if( schedUSE_RELEASE_CALENDAR == 1 )
+		/* The recreated task enters the calendar again at its first release. */
+		prvReleaseCalendarRemove( pxTCB );
+	#endif /* schedUSE_RELEASE_CALENDAR */
+
+	#if( schedUSE_SRP == 1 )
+		/* The abandoned job no longer keeps jobs of the same level from starting. */
+		prvSRPJobEnd( pxTCB );
+	#endif /* schedUSE_SRP */
+
 	vTaskDelete( *pxTCB->pxTaskHandle );
 	pxTCB->xExecTime = 0;
 	prvPeriodicTaskRecreate( pxTCB );	
+
+	#if( schedUSE_SPORADIC_TASKS == 1 )
+		/* A sporadic task waits for its next release, which must still respect the
+		 * minimum inter-arrival time from the last one. */
+		if( pdTRUE == pxTCB->xIsSporadic )
+		{
+			return;
+		}
+	#endif /* schedUSE_SPORADIC_TASKS */
 		
 	/* Need to reset next WakeTime for correct release. */
 	/* your implementation goes here: 
@@ -527,6 +3015,28 @@ static void prvDeleteAndRecreateTask( SchedTCB_t *pxTCB )
 
 		#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 )						
 			/* check if task missed deadline */
+			#if( schedUSE_MK_FIRM == 1 )
+				if( pdTRUE == pxTCB->xIsMKFirm )
+				{
+					if( pdTRUE == pxTCB->xDeadlineExceeded && pdFALSE == pxTCB->xMissTolerated )
+					{
+						if( prvMKRecentMisses( pxTCB ) < pxTCB->uxMaxMisses )
+						{
+							/* The job runs to completion and is recorded as a miss when it ends. */
+							pxTCB->xMissTolerated = pdTRUE;
+						}
+						else if( pxTCB->xWorkIsDone == pdTRUE || pxTCB->xResourceAcquired == pdFALSE )
+						{
+							Serial.print( pxTCB->pcName );
+							Serial.println( ": (m,k) violated!" );
+							prvMKRecordJob( pxTCB, pdTRUE );
+							prvDeleteAndRecreateTask( pxTCB );
+							pxTCB->xDeadlineExceeded = pdFALSE;
+						}
+					}
+				}
+				else
+			#endif /* schedUSE_MK_FIRM */
 			if ( pxTCB->xDeadlineExceeded == pdTRUE && ( pxTCB->xWorkIsDone == pdTRUE || pxTCB->xResourceAcquired == pdFALSE ) )
 			{
 				Serial.print( pxTCB->pcName );
@@ -549,6 +3059,31 @@ static void prvDeleteAndRecreateTask( SchedTCB_t *pxTCB )
 		return;
 	}
 
+	#if( schedUSE_PERIODIC_JOBS == 1 && ( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 || schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 ) )
+		/* A job cannot be deleted and recreated without aborting the other jobs on the
+		 * shared stack, so its timing errors are reported and the job runs on. */
+		static void prvSchedulerCheckJobTimingError( SchedJob_t *pxJob )
+		{
+			#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 )
+				if( pdTRUE == pxJob->xDeadlineExceeded )
+				{
+					Serial.print( pxJob->pcName );
+					Serial.println( ": deadline missed!" );
+					pxJob->xDeadlineExceeded = pdFALSE;
+				}
+			#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE */
+
+			#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
+				if( pdTRUE == pxJob->xMaxExecTimeExceeded )
+				{
+					Serial.print( pxJob->pcName );
+					Serial.println( ": WCET exceed!" );
+					pxJob->xMaxExecTimeExceeded = pdFALSE;
+				}
+			#endif /* schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */
+		}
+	#endif /* schedUSE_PERIODIC_JOBS && ( schedUSE_TIMING_ERROR_DETECTION_DEADLINE || schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME ) */
+
 	/* Function code for the scheduler task. */
 	static void prvSchedulerFunction( void *pvParameters )
 	{
@@ -568,8 +3103,72 @@ static void prvDeleteAndRecreateTask( SchedTCB_t *pxTCB )
 				{
 					prvSchedulerCheckTimingError( xTickCount, &xTCBArray[ xIndex ] );
 				}
-			
-			#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE || schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */
+
+				#if( schedUSE_PERIODIC_JOBS == 1 )
+					for( BaseType_t xIndex = 0; xIndex < xJobCounter; xIndex++ )
+					{
+						prvSchedulerCheckJobTimingError( &xJobArray[ xIndex ] );
+					}
+				#endif /* schedUSE_PERIODIC_JOBS */
+			
+			#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE || schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */
+
+			#if( schedUSE_SPORADIC_SERVER == 1 )
+				if( NULL != xSporadicServer.pxTCB )
+				{
+					prvSporadicServerCheckBudget();
+				}
+			#endif /* schedUSE_SPORADIC_SERVER */
+
+			#if( schedUSE_CBS == 1 )
+				prvReservationUpdatePriorities();
+			#endif /* schedUSE_CBS */
+
+			#if( schedUSE_MODES == 1 )
+				prvModeChangeUpdate();
+			#endif /* schedUSE_MODES */
+
+			#if( schedUSE_TIMING_CHANGES == 1 )
+				if( pdTRUE == xReassignmentPending )
+				{
+					xReassignmentPending = pdFALSE;
+					prvReassignPriorities();
+				}
+			#endif /* schedUSE_TIMING_CHANGES */
+
+			#if( schedUSE_MIXED_CRITICALITY == 1 )
+				prvCriticalityUpdate();
+			#endif /* schedUSE_MIXED_CRITICALITY */
+
+			#if( schedUSE_ELASTIC_TASKS == 1 )
+				prvElasticUpdate();
+			#endif /* schedUSE_ELASTIC_TASKS */
+
+			#if( schedUSE_DUAL_PRIORITY == 1 )
+				prvDualPriorityUpdate();
+			#endif /* schedUSE_DUAL_PRIORITY */
+
+			#if( schedUSE_TELEMETRY == 1 )
+				for( BaseType_t xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+				{
+					prvUpdateStackHighWaterMark( &xTCBArray[ xIndex ] );
+				}
+
+				#if( schedUSE_STACK_CALIBRATION == 1 )
+					if( pdFALSE == xCalibrationDone )
+					{
+						TickType_t xNow = xTaskGetTickCount();
+						ulCalibrationElapsedTicks += ( TickType_t ) ( xNow - xCalibrationLastTick );
+						xCalibrationLastTick = xNow;
+						if( ulCalibrationElapsedTicks >= ulCalibrationTicks )
+						{
+							Serial.println( "Stack calibration done" );
+							vSchedulerPrintTelemetry();
+							xCalibrationDone = pdTRUE;
+						}
+					}
+				#endif /* schedUSE_STACK_CALIBRATION */
+			#endif /* schedUSE_TELEMETRY */
 
 			#if ( SCHEDULER_OVERHEAD_DUMMY_LOOP == 1 )
 				Serial.println("s");
@@ -607,13 +3206,117 @@ static void prvDeleteAndRecreateTask( SchedTCB_t *pxTCB )
 		   priority inheritance. */
 		TaskHandle_t xCurrentTaskHandle = xTaskGetCurrentTaskHandle();
 		BaseType_t xCurrentTaskIndex = prvGetTCBIndexFromHandle( xCurrentTaskHandle );
-		SchedTCB_t *pxCurrentTask = &xTCBArray[ xCurrentTaskIndex ];
+		/* Tasks outside the TCB array, such as the timer task, are not supervised. */
+		SchedTCB_t *pxCurrentTask = ( -1 == xCurrentTaskIndex ) ? NULL : &xTCBArray[ xCurrentTaskIndex ];
+
+		#if( schedUSE_RELEASE_CALENDAR == 1 )
+			prvReleaseCalendarTick( xTaskGetTickCountFromISR() );
+		#endif /* schedUSE_RELEASE_CALENDAR */
+
+		#if( schedUSE_PERIODIC_JOBS == 1 )
+			if( NULL != pxCurrentTask && xCurrentTaskHandle == xJobDispatcherHandle )
+			{
+				if( NULL != pxRunningJob )
+				{
+					pxRunningJob->xExecTime++;
+				}
+				/* Jobs are supervised one by one, the dispatcher is never deleted mid-batch. */
+				pxCurrentTask = NULL;
+			}
+		#endif /* schedUSE_PERIODIC_JOBS */
+
+		#if( schedUSE_SPORADIC_SERVER == 1 )
+			if( NULL != xSporadicServer.pxTCB )
+			{
+				prvSporadicServerTick( xTaskGetTickCountFromISR(), ( BaseType_t ) ( pxCurrentTask == xSporadicServer.pxTCB ) );
+				if( pxCurrentTask == xSporadicServer.pxTCB )
+				{
+					/* The server is bounded by its budget instead of the WCET and deadline checks. */
+					pxCurrentTask = NULL;
+				}
+			}
+		#endif /* schedUSE_SPORADIC_SERVER */
+
+		#if( schedUSE_DUAL_PRIORITY == 1 )
+			TickType_t xPromotionTickCount = xTaskGetTickCountFromISR();
+			for( BaseType_t xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+			{
+				SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+				if( pdFALSE == pxTCB->xPromoted && pdFALSE == pxTCB->xPromotionDue && pdFALSE == pxTCB->xWorkIsDone &&
+					( TickType_t ) ( xPromotionTickCount - pxTCB->xPromotionTime ) <= ( portMAX_DELAY >> 1 ) )
+				{
+					pxTCB->xPromotionDue = pdTRUE;
+					prvWakeScheduler();
+				}
+			}
+		#endif /* schedUSE_DUAL_PRIORITY */
+
+		#if( schedUSE_MIXED_CRITICALITY == 1 )
+			if( schedCRITICALITY_HI == xSystemCriticality && pdFALSE == xCriticalityRaised && pdFALSE == xCriticalityLowered &&
+				xCurrentTaskHandle == xTaskGetIdleTaskHandle() )
+			{
+				/* No HI job is pending at an idle instant, so LO mode can resume. */
+				xCriticalityLowered = pdTRUE;
+				prvWakeScheduler();
+			}
+		#endif /* schedUSE_MIXED_CRITICALITY */
+
+		#if( schedUSE_MODES == 1 )
+			if( eModeWaitingForIdle == eModeChangeState && xCurrentTaskHandle == xTaskGetIdleTaskHandle() )
+			{
+				eModeChangeState = eModeReleaseDue;
+				prvWakeScheduler();
+			}
+		#endif /* schedUSE_MODES */
+
+		#if( schedUSE_CBS == 1 )
+			TickType_t xTickCount = xTaskGetTickCountFromISR();
+			for( BaseType_t xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+			{
+				SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+
+				/* The task returns to its priority at the deadline it had before the postponement. */
+				if( pdTRUE == pxTCB->xHasReservation && pdTRUE == pxTCB->xIsDemoted && pdFALSE == pxTCB->xRestorePending &&
+					( TickType_t ) ( xTickCount - ( pxTCB->xServerDeadline - pxTCB->xServerPeriod ) ) <= ( portMAX_DELAY >> 1 ) )
+				{
+					pxTCB->xRestorePending = pdTRUE;
+					prvWakeScheduler();
+				}
+			}
+
+			if( NULL != pxCurrentTask && pdTRUE == pxCurrentTask->xHasReservation )
+			{
+				pxCurrentTask->xExecTime++;
+				prvReservationCharge( pxCurrentTask );
+				/* Soft tasks are bounded by their budget instead of the WCET and deadline checks. */
+				pxCurrentTask = NULL;
+			}
+		#endif /* schedUSE_CBS */
 		
-		if( xCurrentTaskHandle != xSchedulerHandle && xCurrentTaskHandle != xTaskGetIdleTaskHandle() )
+		if( NULL != pxCurrentTask && xCurrentTaskHandle != xSchedulerHandle && xCurrentTaskHandle != xTaskGetIdleTaskHandle() )
 		{
 			pxCurrentTask->xExecTime++;
      
-			#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
+			#if( schedUSE_MIXED_CRITICALITY == 1 )
+				if( schedCRITICALITY_LO == xSystemCriticality && schedCRITICALITY_HI == pxCurrentTask->xCriticality &&
+					pxCurrentTask->xMaxExecTime <= pxCurrentTask->xExecTime )
+				{
+					/* A HI task overran its LO budget: switch to HI mode instead of treating it as an error. */
+					xSystemCriticality = schedCRITICALITY_HI;
+					xCriticalityRaised = pdTRUE;
+					prvWakeScheduler();
+				}
+			#endif /* schedUSE_MIXED_CRITICALITY */
+
+			#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 && schedUSE_MIXED_CRITICALITY == 1 )
+            	if( prvGetMaxExecTime( pxCurrentTask, xSystemCriticality ) <= pxCurrentTask->xExecTime )
+            	{
+               		if( pdFALSE == pxCurrentTask->xMaxExecTimeExceeded )
+                	{
+                    	prvExecTimeExceedHook( pxCurrentTask );
+                	}
+            	}
+			#elif( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
             	if( pxCurrentTask->xMaxExecTime <= pxCurrentTask->xExecTime )
             	{
                		if( pdFALSE == pxCurrentTask->xMaxExecTimeExceeded )
@@ -653,6 +3356,18 @@ static void prvDeleteAndRecreateTask( SchedTCB_t *pxTCB )
 		BaseType_t xCurrentTaskIndex = prvGetTCBIndexFromHandle( xCurrentTaskHandle );
 		SchedTCB_t *pxThisTask = &xTCBArray[ xCurrentTaskIndex ];
 
+		#if( schedUSE_SRP == 1 )
+			/* Raise to the ceiling first. Every other user now either holds the resource
+			 * already, which the start rule rules out, or cannot start, so the take does
+			 * not block. */
+			UBaseType_t uxSavedPriority = uxTaskPriorityGet( NULL );
+			SchedResource_t *pxResource = prvGetResource( xSemaphore );
+			if( NULL != pxResource && pxResource->uxCeiling > uxSavedPriority )
+			{
+				vTaskPrioritySet( NULL, pxResource->uxCeiling );
+			}
+		#endif /* schedUSE_SRP */
+
 		BaseType_t status = xSemaphoreTake( xSemaphore, portMAX_DELAY );
 
 		/* If the mutex is acquired successfully, the task holds the resource */
@@ -673,8 +3388,20 @@ static void prvDeleteAndRecreateTask( SchedTCB_t *pxTCB )
 				}
     		}
 			pxThisTask->xAcquiredSemaphores[xIndex] = xSemaphore;
+			#if( schedUSE_SRP == 1 )
+				if( 0 == pxThisTask->xSemaphoreCount )
+				{
+					pxThisTask->uxSRPBasePriority = uxSavedPriority;
+				}
+			#endif /* schedUSE_SRP */
 			pxThisTask->xSemaphoreCount++;
 		}
+		#if( schedUSE_SRP == 1 )
+			else
+			{
+				vTaskPrioritySet( NULL, uxSavedPriority );
+			}
+		#endif /* schedUSE_SRP */
 
 		return status;
 	}
@@ -708,9 +3435,26 @@ static void prvDeleteAndRecreateTask( SchedTCB_t *pxTCB )
 			pxThisTask->xAcquiredSemaphores[xIndex] = NULL;
 			pxThisTask->xSemaphoreCount--;
 
+			#if( schedUSE_SRP == 1 )
+				/* Resources may be given back in any order, so the priority is derived from
+				 * the ones still held. Jobs kept out by the ceiling may start now. */
+				taskENTER_CRITICAL();
+				vTaskPrioritySet( NULL, prvSRPHolderPriority( pxThisTask ) );
+				prvSRPWakeWaiters();
+				taskEXIT_CRITICAL();
+			#endif /* schedUSE_SRP */
+
 			if ( pxThisTask->xSemaphoreCount == 0 )
 			{
 				pxThisTask->xResourceAcquired = pdFALSE;
+
+				#if( schedUSE_MIXED_CRITICALITY == 1 )
+					/* The job was kept running in HI mode only to give its resources back. */
+					if( pdTRUE == pxThisTask->xDropPending )
+					{
+						xTaskNotifyGive( xSchedulerHandle );
+					}
+				#endif /* schedUSE_MIXED_CRITICALITY */
 			}
 		}
 
@@ -718,6 +3462,509 @@ static void prvDeleteAndRecreateTask( SchedTCB_t *pxTCB )
 	}	
 #endif
 
+#if( schedUSE_TELEMETRY == 1 )
+	static void prvUpdateStackHighWaterMark( SchedTCB_t *pxTCB )
+	{
+		if( NULL != *pxTCB->pxTaskHandle )
+		{
+			configSTACK_DEPTH_TYPE uxHighWaterMark = uxTaskGetStackHighWaterMark( *pxTCB->pxTaskHandle );
+			if( uxHighWaterMark < pxTCB->uxStackHighWaterMark )
+			{
+				pxTCB->uxStackHighWaterMark = uxHighWaterMark;
+			}
+		}
+	}
+
+	#if( schedUSE_STACK_CALIBRATION == 1 && schedUSE_SCHEDULER_TASK == 1 )
+		static uint32_t prvGetHyperperiod( void )
+		{
+			uint32_t ulHyperperiod = 1;
+
+			for( BaseType_t xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+			{
+				uint32_t ulA = ulHyperperiod, ulB = xTCBArray[ xIndex ].xPeriod;
+				while( 0 != ulB )
+				{
+					uint32_t ulTemp = ulA % ulB;
+					ulA = ulB;
+					ulB = ulTemp;
+				}
+
+				/* lcm = a / gcd * b, saturated so that a large task set still terminates. */
+				uint32_t ulFactor = ulHyperperiod / ulA;
+				if( 0 != xTCBArray[ xIndex ].xPeriod && ulFactor > UINT32_MAX / xTCBArray[ xIndex ].xPeriod )
+				{
+					return UINT32_MAX;
+				}
+				ulHyperperiod = ulFactor * xTCBArray[ xIndex ].xPeriod;
+			}
+
+			return ulHyperperiod;
+		}
+	#endif /* schedUSE_STACK_CALIBRATION */
+
+	/* Fills pxTelemetry with the stack usage of a periodic task. */
+	BaseType_t xSchedulerGetTaskTelemetry( TaskHandle_t xTaskHandle, SchedTaskTelemetry_t *pxTelemetry )
+	{
+		configASSERT( pxTelemetry != NULL );
+
+		BaseType_t xIndex = prvGetTCBIndexFromHandle( xTaskHandle );
+		if( -1 == xIndex )
+		{
+			return pdFAIL;
+		}
+
+		SchedTCB_t *pxTCB = &xTCBArray[ xIndex ];
+		prvUpdateStackHighWaterMark( pxTCB );
+
+		pxTelemetry->pcName = pxTCB->pcName;
+		pxTelemetry->uxStackDepth = pxTCB->uxStackDepth;
+		pxTelemetry->uxStackHighWaterMark = pxTCB->uxStackHighWaterMark;
+		pxTelemetry->uxRecommendedStackDepth = ( pxTCB->uxStackDepth - pxTCB->uxStackHighWaterMark ) + schedSTACK_CALIBRATION_MARGIN;
+		#if( schedUSE_RELEASE_CALENDAR == 1 )
+			pxTelemetry->xMaxReleaseJitter = pxTCB->xMaxReleaseJitter;
+		#endif /* schedUSE_RELEASE_CALENDAR */
+
+		return pdPASS;
+	}
+
+	/* Fills pxTelemetry with the current state of the heap. */
+	void vSchedulerGetHeapTelemetry( SchedHeapTelemetry_t *pxTelemetry )
+	{
+		HeapStats_t xHeapStats;
+
+		configASSERT( pxTelemetry != NULL );
+
+		vPortGetHeapStats( &xHeapStats );
+		pxTelemetry->xFreeBytes = xHeapStats.xAvailableHeapSpaceInBytes;
+		pxTelemetry->xMinimumEverFreeBytes = xHeapStats.xMinimumEverFreeBytesRemaining;
+		pxTelemetry->xLargestFreeBlock = xHeapStats.xSizeOfLargestFreeBlockInBytes;
+		pxTelemetry->uxFragmentationPercent = 0;
+		if( 0 != xHeapStats.xAvailableHeapSpaceInBytes )
+		{
+			pxTelemetry->uxFragmentationPercent = ( UBaseType_t ) ( 100UL - ( ( uint32_t ) xHeapStats.xSizeOfLargestFreeBlockInBytes * 100UL ) / xHeapStats.xAvailableHeapSpaceInBytes );
+		}
+	}
+
+	/* Prints stack usage of all periodic tasks and heap usage on the serial port. */
+	void vSchedulerPrintTelemetry( void )
+	{
+		SchedTaskTelemetry_t xTaskTelemetry;
+		SchedHeapTelemetry_t xHeapTelemetry;
+
+		for( BaseType_t xIndex = 0; xIndex < xTaskCounter; xIndex++ )
+		{
+			if( pdPASS == xSchedulerGetTaskTelemetry( *xTCBArray[ xIndex ].pxTaskHandle, &xTaskTelemetry ) )
+			{
+				Serial.print( xTaskTelemetry.pcName );
+				Serial.print( ": stack=" );
+				Serial.print( xTaskTelemetry.uxStackDepth );
+				Serial.print( " hwm=" );
+				Serial.print( xTaskTelemetry.uxStackHighWaterMark );
+				Serial.print( " rec=" );
+				#if( schedUSE_RELEASE_CALENDAR == 1 )
+					Serial.print( xTaskTelemetry.uxRecommendedStackDepth );
+					Serial.print( " jitter=" );
+					Serial.println( xTaskTelemetry.xMaxReleaseJitter );
+				#else
+					Serial.println( xTaskTelemetry.uxRecommendedStackDepth );
+				#endif /* schedUSE_RELEASE_CALENDAR */
+			}
+		}
+
+		#if( schedUSE_SCHEDULER_TASK == 1 )
+			if( NULL != xSchedulerHandle )
+			{
+				Serial.print( "Scheduler: stack=" );
+				Serial.print( schedSCHEDULER_TASK_STACK_SIZE );
+				Serial.print( " hwm=" );
+				Serial.println( uxTaskGetStackHighWaterMark( xSchedulerHandle ) );
+			}
+		#endif /* schedUSE_SCHEDULER_TASK */
+
+		vSchedulerGetHeapTelemetry( &xHeapTelemetry );
+		Serial.print( "heap: free=" );
+		Serial.print( xHeapTelemetry.xFreeBytes );
+		Serial.print( " min=" );
+		Serial.print( xHeapTelemetry.xMinimumEverFreeBytes );
+		Serial.print( " largest=" );
+		Serial.print( xHeapTelemetry.xLargestFreeBlock );
+		Serial.print( " frag=" );
+		Serial.print( xHeapTelemetry.uxFragmentationPercent );
+		Serial.println( "%" );
+	}
+#endif /* schedUSE_TELEMETRY */
+
+#if( schedUSE_PERIODIC_JOBS == 1 )
+	/* Creates a periodic run-to-completion job. */
+	void vSchedulerPeriodicJobCreate( TaskFunction_t pvJobCode, const char *pcName, void *pvParameters,
+			TickType_t xPhaseTick, TickType_t xPeriodTick, TickType_t xMaxExecTimeTick, TickType_t xDeadlineTick )
+	{
+		configASSERT( xJobCounter < schedMAX_NUMBER_OF_PERIODIC_JOBS );
+		configASSERT( xPeriodTick > 0 );
+
+		taskENTER_CRITICAL();
+		SchedJob_t *pxJob = &xJobArray[ xJobCounter ];
+		pxJob->pvJobCode = pvJobCode;
+		pxJob->pcName = pcName;
+		pxJob->pvParameters = pvParameters;
+		pxJob->xPeriod = xPeriodTick;
+		pxJob->xMaxExecTime = xMaxExecTimeTick;
+		pxJob->xRelativeDeadline = xDeadlineTick;
+		pxJob->xNextRelease = xPhaseTick;
+		#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 )
+			pxJob->xDeadlineExceeded = pdFALSE;
+		#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE */
+		#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
+			pxJob->xMaxExecTimeExceeded = pdFALSE;
+		#endif /* schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */
+		xJobCounter++;
+		taskEXIT_CRITICAL();
+	}
+
+	/* Runs every due job, always picking the highest priority one next, so a job that
+	 * becomes due while another runs is served in priority order at the next job boundary. */
+	static void prvJobDispatcherCode( void *pvParameters )
+	{
+		for( ; ; )
+		{
+			TickType_t xNow = xTaskGetTickCount();
+			SchedJob_t *pxJob = NULL;
+
+			for( BaseType_t xIndex = 0; xIndex < xJobCounter; xIndex++ )
+			{
+				/* Wrap-safe test for xNextRelease <= xNow. */
+				if( ( TickType_t ) ( xNow - xJobArray[ xIndex ].xNextRelease ) <= ( portMAX_DELAY >> 1 ) )
+				{
+					pxJob = &xJobArray[ xIndex ];
+					break;
+				}
+			}
+
+			if( NULL == pxJob )
+			{
+				break;
+			}
+
+			TickType_t xRelease = pxJob->xNextRelease;
+			pxJob->xNextRelease += pxJob->xPeriod;
+			pxJob->xExecTime = 0;
+			pxRunningJob = pxJob;
+			pxJob->pvJobCode( pxJob->pvParameters );
+			pxRunningJob = NULL;
+
+			/* Timing errors are flagged once per job, when it returns, and handled by the
+			 * scheduler task along with those of the periodic tasks. */
+			#if( schedUSE_SCHEDULER_TASK == 1 && ( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 || schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 ) )
+				BaseType_t xTimingError = pdFALSE;
+
+				#if( schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME == 1 )
+					if( pxJob->xExecTime > pxJob->xMaxExecTime )
+					{
+						pxJob->xMaxExecTimeExceeded = pdTRUE;
+						xTimingError = pdTRUE;
+					}
+				#endif /* schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME */
+
+				#if( schedUSE_TIMING_ERROR_DETECTION_DEADLINE == 1 )
+					if( ( TickType_t ) ( xTaskGetTickCount() - xRelease ) > pxJob->xRelativeDeadline )
+					{
+						pxJob->xDeadlineExceeded = pdTRUE;
+						xTimingError = pdTRUE;
+					}
+				#else
+					( void ) xRelease;
+				#endif /* schedUSE_TIMING_ERROR_DETECTION_DEADLINE */
+
+				if( pdTRUE == xTimingError )
+				{
+					xTaskNotifyGive( xSchedulerHandle );
+				}
+			#else
+				( void ) xRelease;
+			#endif /* schedUSE_SCHEDULER_TASK && ( schedUSE_TIMING_ERROR_DETECTION_DEADLINE || schedUSE_TIMING_ERROR_DETECTION_EXECUTION_TIME ) */
+		}
+	}
+
+	/* All jobs share one dispatcher, and so one stack, whatever their priorities: one
+	 * dispatcher per priority level would need a stack per level again. The dispatcher is
+	 * released at every multiple of the gcd of all periods and phases, which includes every
+	 * job release, and is ranked by that period under RMS and by the tightest job deadline
+	 * under DMS. Its WCET, the sum of the job WCETs, only bounds the blocking it can cause;
+	 * the analysis charges it for the jobs it runs and checks every job on its own. */
+	static void prvCreateJobDispatcher( void )
+	{
+		TickType_t xPeriod = 0, xDeadline = portMAX_DELAY;
+		uint32_t ulExecTime = 0;
+
+		/* Sort by priority so the dispatcher can take the first due job. */
+		for( BaseType_t xIndex = 1; xIndex < xJobCounter; xIndex++ )
+		{
+			SchedJob_t xJob = xJobArray[ xIndex ];
+			BaseType_t xHole = xIndex;
+
+			#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_RMS )
+				while( xHole > 0 && xJobArray[ xHole - 1 ].xPeriod > xJob.xPeriod )
+			#else
+				while( xHole > 0 && xJobArray[ xHole - 1 ].xRelativeDeadline > xJob.xRelativeDeadline )
+			#endif /* schedSCHEDULING_POLICY */
+			{
+				xJobArray[ xHole ] = xJobArray[ xHole - 1 ];
+				xHole--;
+			}
+			xJobArray[ xHole ] = xJob;
+		}
+
+		for( BaseType_t xIndex = 0; xIndex < xJobCounter; xIndex++ )
+		{
+			SchedJob_t *pxJob = &xJobArray[ xIndex ];
+			TickType_t xValues[ 2 ] = { pxJob->xPeriod, pxJob->xNextRelease };
+
+			for( BaseType_t xValue = 0; xValue < 2; xValue++ )
+			{
+				TickType_t xA = xPeriod, xB = xValues[ xValue ];
+				while( 0 != xB )
+				{
+					TickType_t xTemp = xA % xB;
+					xA = xB;
+					xB = xTemp;
+				}
+				xPeriod = xA;
+			}
+
+			ulExecTime += pxJob->xMaxExecTime;
+			xDeadline = ( pxJob->xRelativeDeadline < xDeadline ) ? pxJob->xRelativeDeadline : xDeadline;
+			pxJob->xNextRelease += xSystemStartTime;
+		}
+
+		if( ulExecTime > portMAX_DELAY )
+		{
+			ulExecTime = portMAX_DELAY;
+		}
+
+		vSchedulerPeriodicTaskCreate( prvJobDispatcherCode, "Jobs", schedJOB_DISPATCHER_STACK_SIZE, NULL, 0,
+				&xJobDispatcherHandle, 0, xPeriod, ( TickType_t ) ulExecTime, xDeadline );
+
+		#if( schedUSE_PREEMPTION_THRESHOLDS == 1 )
+			/* A started batch has no fixed length, so a raised threshold would block for an
+			 * unbounded time. The dispatcher keeps its priority. */
+			vSchedulerPeriodicTaskSetPreemptionThreshold( &xJobDispatcherHandle, 0 );
+		#endif /* schedUSE_PREEMPTION_THRESHOLDS */
+	}
+
+	#if( schedUSE_RESPONSE_TIME_ANALYSIS == 1 )
+		static uint32_t prvJobDemand( BaseType_t xJobs, uint32_t ulTime, BaseType_t xClosed )
+		{
+			uint32_t ulDemand = 0;
+
+			for( BaseType_t xIndex = 0; xIndex < xJobs; xIndex++ )
+			{
+				SchedJob_t *pxJob = &xJobArray[ xIndex ];
+				uint32_t ulReleases = ( pdTRUE == xClosed ) ? ulTime / pxJob->xPeriod + 1 : ( ulTime + pxJob->xPeriod - 1 ) / pxJob->xPeriod;
+				ulDemand += ulReleases * pxJob->xMaxExecTime;
+			}
+
+			return ulDemand;
+		}
+
+		static uint32_t prvJobUtilisation( BaseType_t xJobs )
+		{
+			uint32_t ulUtilisation = 0;
+
+			for( BaseType_t xIndex = 0; xIndex < xJobs; xIndex++ )
+			{
+				ulUtilisation += ( ( uint32_t ) xJobArray[ xIndex ].xMaxExecTime * 1024UL + xJobArray[ xIndex ].xPeriod - 1 ) / xJobArray[ xIndex ].xPeriod;
+			}
+
+			return ulUtilisation;
+		}
+
+		/* Jobs do not preempt each other, so each job is analysed on its own at the priority
+		 * of the dispatcher: it may wait for one started lower priority job, or for a lower
+		 * priority task blocking the dispatcher, and is delayed until it starts by the higher
+		 * priority jobs. The result is the dispatcher's deadline, the tightest job deadline,
+		 * plus the largest lateness of any job. It meets that deadline exactly when every job
+		 * meets its own, and leaves the smallest job slack to the dual priority offsets. */
+		static uint32_t prvJobDispatcherResponseTime( BaseType_t xTask, uint32_t ulBlocking )
+		{
+			uint32_t ulDeadline = xTCBArray[ xTask ].xRelativeDeadline, ulLowerJob = 0, ulWorst = 0;
+
+			for( BaseType_t xIndex = xJobCounter; xIndex-- > 0; )
+			{
+				SchedJob_t *pxJob = &xJobArray[ xIndex ];
+				uint32_t ulResponseTime = prvResponseTimeOf( xTask, pxJob->xMaxExecTime, pxJob->xPeriod,
+						( ulLowerJob > ulBlocking ) ? ulLowerJob : ulBlocking, xIndex );
+
+				if( UINT32_MAX == ulResponseTime )
+				{
+					return UINT32_MAX;
+				}
+				if( ulResponseTime + ulDeadline > pxJob->xRelativeDeadline + ulWorst )
+				{
+					ulWorst = ulResponseTime + ulDeadline - pxJob->xRelativeDeadline;
+				}
+				if( pxJob->xMaxExecTime > ulLowerJob )
+				{
+					ulLowerJob = pxJob->xMaxExecTime;
+				}
+			}
+
+			return ulWorst;
+		}
+	#endif /* schedUSE_RESPONSE_TIME_ANALYSIS */
+#endif /* schedUSE_PERIODIC_JOBS */
+
+#if( schedUSE_SPORADIC_SERVER == 1 )
+	/* Creates the sporadic server. */
+	void vSchedulerSporadicServerCreate( configSTACK_DEPTH_TYPE uxStackDepth, UBaseType_t uxQueueLength, TickType_t xPeriodTick, TickType_t xBudgetTick )
+	{
+		configASSERT( xSporadicServer.pxTCB == NULL );
+		configASSERT( xBudgetTick > 0 && xBudgetTick <= xPeriodTick );
+
+		xSporadicServer.xJobQueue = xQueueCreate( uxQueueLength, sizeof( AperiodicJob_t ) );
+		configASSERT( xSporadicServer.xJobQueue != NULL );
+
+		/* For analysis the server is a periodic task with its budget as WCET. */
+		vSchedulerPeriodicTaskCreate( NULL, "Server", uxStackDepth, NULL, 0, &xSporadicServerHandle, 0, xPeriodTick, xBudgetTick, xPeriodTick );
+
+		xSporadicServer.pxTCB = prvGetTCBFromCreatedTask( &xSporadicServerHandle );
+		configASSERT( xSporadicServer.pxTCB != NULL );
+		xSporadicServer.xRemainingBudget = xBudgetTick;
+		xSporadicServer.xIsActive = pdFALSE;
+		xSporadicServer.xIsExhausted = pdFALSE;
+		xSporadicServer.uxReplenishmentCount = 0;
+	}
+
+	/* Queues an aperiodic job. */
+	BaseType_t xSchedulerAperiodicJobSubmit( TaskFunction_t pvJobCode, void *pvParameters, TickType_t xTicksToWait )
+	{
+		AperiodicJob_t xJob = { pvJobCode, pvParameters };
+
+		configASSERT( xSporadicServer.xJobQueue != NULL );
+		return xQueueSend( xSporadicServer.xJobQueue, &xJob, xTicksToWait );
+	}
+
+	/* Queues an aperiodic job from an interrupt. */
+	BaseType_t xSchedulerAperiodicJobSubmitFromISR( TaskFunction_t pvJobCode, void *pvParameters, BaseType_t *pxHigherPriorityTaskWoken )
+	{
+		AperiodicJob_t xJob = { pvJobCode, pvParameters };
+
+		configASSERT( xSporadicServer.xJobQueue != NULL );
+		return xQueueSendFromISR( xSporadicServer.xJobQueue, &xJob, pxHigherPriorityTaskWoken );
+	}
+
+	static void prvSporadicServerCode( SchedTCB_t *pxThisTask )
+	{
+		AperiodicJob_t xJob;
+
+		for( ; ; )
+		{
+			pxThisTask->xWorkIsDone = pdTRUE;
+			xQueueReceive( xSporadicServer.xJobQueue, &xJob, portMAX_DELAY );
+			pxThisTask->xWorkIsDone = pdFALSE;
+
+			xJob.pvJobCode( xJob.pvParameters );
+
+			/* The server becomes idle with the last queued job. */
+			taskENTER_CRITICAL();
+			if( 0 == uxQueueMessagesWaiting( xSporadicServer.xJobQueue ) )
+			{
+				prvSporadicServerDeactivate();
+			}
+			taskEXIT_CRITICAL();
+		}
+	}
+
+	static void prvSporadicServerDeactivate( void )
+	{
+		if( pdFALSE == xSporadicServer.xIsActive )
+		{
+			return;
+		}
+		xSporadicServer.xIsActive = pdFALSE;
+
+		if( 0 == xSporadicServer.xConsumedBudget )
+		{
+			return;
+		}
+
+		TickType_t xTime = xSporadicServer.xActivationTime + xSporadicServer.pxTCB->xPeriod;
+		if( xSporadicServer.uxReplenishmentCount < schedSPORADIC_SERVER_MAX_REPLENISHMENTS )
+		{
+			Replenishment_t *pxReplenishment = &xSporadicServer.xReplenishments[ xSporadicServer.uxReplenishmentCount ];
+			pxReplenishment->xTime = xTime;
+			pxReplenishment->xAmount = xSporadicServer.xConsumedBudget;
+			xSporadicServer.uxReplenishmentCount++;
+		}
+		else
+		{
+			/* Postponing the last replenishment keeps the server within its bandwidth. */
+			Replenishment_t *pxReplenishment = &xSporadicServer.xReplenishments[ schedSPORADIC_SERVER_MAX_REPLENISHMENTS - 1 ];
+			pxReplenishment->xTime = xTime;
+			pxReplenishment->xAmount += xSporadicServer.xConsumedBudget;
+		}
+		xSporadicServer.xConsumedBudget = 0;
+	}
+
+	static void prvSporadicServerTick( TickType_t xTickCount, BaseType_t xServerIsRunning )
+	{
+		/* Replenishments are posted in time order, so only the first can be due. */
+		while( xSporadicServer.uxReplenishmentCount > 0 &&
+			( TickType_t ) ( xTickCount - xSporadicServer.xReplenishments[ 0 ].xTime ) <= ( portMAX_DELAY >> 1 ) )
+		{
+			xSporadicServer.xRemainingBudget += xSporadicServer.xReplenishments[ 0 ].xAmount;
+			if( xSporadicServer.xRemainingBudget > xSporadicServer.pxTCB->xMaxExecTime )
+			{
+				xSporadicServer.xRemainingBudget = xSporadicServer.pxTCB->xMaxExecTime;
+			}
+
+			xSporadicServer.uxReplenishmentCount--;
+			for( UBaseType_t uxIndex = 0; uxIndex < xSporadicServer.uxReplenishmentCount; uxIndex++ )
+			{
+				xSporadicServer.xReplenishments[ uxIndex ] = xSporadicServer.xReplenishments[ uxIndex + 1 ];
+			}
+		}
+
+		if( pdTRUE == xSporadicServer.xIsExhausted && xSporadicServer.xRemainingBudget > 0 )
+		{
+			xSporadicServer.xIsExhausted = pdFALSE;
+			xTaskResumeFromISR( xSporadicServerHandle );
+		}
+
+		if( pdFALSE == xServerIsRunning || 0 == xSporadicServer.xRemainingBudget )
+		{
+			return;
+		}
+
+		if( pdFALSE == xSporadicServer.xIsActive )
+		{
+			xSporadicServer.xIsActive = pdTRUE;
+			xSporadicServer.xActivationTime = xTickCount;
+			xSporadicServer.xConsumedBudget = 0;
+		}
+		xSporadicServer.xRemainingBudget--;
+		xSporadicServer.xConsumedBudget++;
+
+		if( 0 == xSporadicServer.xRemainingBudget )
+		{
+			prvSporadicServerDeactivate();
+			xSporadicServer.xIsExhausted = pdTRUE;
+			prvWakeScheduler();
+		}
+	}
+
+	static void prvSporadicServerCheckBudget( void )
+	{
+		/* The tick hook may have replenished the budget since it woke the scheduler task. */
+		taskENTER_CRITICAL();
+		if( pdTRUE == xSporadicServer.xIsExhausted )
+		{
+			vTaskSuspend( xSporadicServerHandle );
+		}
+		taskEXIT_CRITICAL();
+	}
+#endif /* schedUSE_SPORADIC_SERVER */
+
 /* This function must be called before any other function call from this module. */
 void vSchedulerInit( void )
 {
@@ -730,15 +3977,48 @@ void vSchedulerInit( void )
  * have been created with API function before calling this function. */
 void vSchedulerStart( void )
 {
+	#if( schedUSE_PERIODIC_JOBS == 1 )
+		if( xJobCounter > 0 )
+		{
+			prvCreateJobDispatcher();
+		}
+	#endif /* schedUSE_PERIODIC_JOBS */
+
 	#if( schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_RMS || schedSCHEDULING_POLICY == schedSCHEDULING_POLICY_DMS )
-		prvSetFixedPriorities();	
+		BaseType_t xOptimal = prvAssignPriorities();
+		#if( schedUSE_DEBUG_PRINTS == 1 )
+			if( pdTRUE == xOptimal )
+			{
+				Serial.println( "Using Audsley priority order" );
+			}
+		#else
+			( void ) xOptimal;
+		#endif /* schedUSE_DEBUG_PRINTS */
+		/* No task exists yet, so the assignment can be published as it is. */
+		prvPublishAssignment();
 	#endif /* schedSCHEDULING_POLICY */
 
+	#if( schedUSE_RESPONSE_TIME_ANALYSIS == 1 && schedUSE_DEBUG_PRINTS == 1 )
+		if( pdFALSE == prvIsTaskSetSchedulable( pdTRUE ) )
+		{
+			Serial.println( "Task set is not schedulable!" );
+		}
+	#endif /* schedUSE_RESPONSE_TIME_ANALYSIS && schedUSE_DEBUG_PRINTS */
+
 	#if( schedUSE_SCHEDULER_TASK == 1 )
 		prvCreateSchedulerTask();
 	#endif /* schedUSE_SCHEDULER_TASK */
 
+	#if( schedUSE_TELEMETRY == 1 && schedUSE_STACK_CALIBRATION == 1 && schedUSE_SCHEDULER_TASK == 1 )
+		uint32_t ulHyperperiod = prvGetHyperperiod();
+		ulCalibrationTicks = ( ulHyperperiod > UINT32_MAX / schedCALIBRATION_HYPERPERIODS ) ? UINT32_MAX : ulHyperperiod * schedCALIBRATION_HYPERPERIODS;
+	#endif /* schedUSE_STACK_CALIBRATION */
+
 	prvCreateAllTasks();
+
+	#if( schedUSE_MODES == 1 )
+		prvSuspendTasksOutsideMode();
+	#endif /* schedUSE_MODES */
 	  
 	xSystemStartTime = xTaskGetTickCount();
 	
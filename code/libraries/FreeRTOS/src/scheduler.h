@@ -18,6 +18,8 @@
 #include <portmacro.h>
 #include <event_groups.h>
 #include <queue.h>
+#include <ring_channel.h>
+#include <direct_timer.h>
 #include <Arduino.h>
 
 
@@ -58,12 +60,233 @@ extern "C" {
 #if( schedUSE_SCHEDULER_TASK == 1 )
 	/* Priority of the scheduler task. */
 	#define schedSCHEDULER_PRIORITY ( configMAX_PRIORITIES - 1 )
-	/* Stack size of the scheduler task. */
-	#define schedSCHEDULER_TASK_STACK_SIZE 200 
+	/* Stack size of the scheduler task. Its deepest path is the priority reassignment
+	 * after a timing change, where the response-time analysis nests nine calls deep.
+	 * That path is estimated at about 190 bytes on the ATmega2560, plus about 90 for
+	 * the tick interrupt and its hook on top of it. vSchedulerPrintTelemetry() reports
+	 * the high-water mark of the scheduler task, so the size can be trimmed to what a
+	 * given configuration really uses. */
+	#define schedSCHEDULER_TASK_STACK_SIZE 320
 	/* The period of the scheduler task in software ticks. */
 	#define schedSCHEDULER_TASK_PERIOD pdMS_TO_TICKS( 100 )	
 #endif /* schedUSE_SCHEDULER_TASK */
 
+/* Set this define to 1 to print the response time of every task when the scheduler
+ * starts, and mode and criticality changes as they happen. Meant for development;
+ * deadline misses and WCET overruns are printed either way. */
+#define schedUSE_DEBUG_PRINTS 0
+
+/* Set this define to 1 to enable run-to-completion periodic jobs. Jobs do not get
+ * a stack of their own: all of them run on the stack of a single dispatcher task,
+ * which is scheduled as one periodic task and runs due jobs in RMS/DMS order. One
+ * dispatcher per priority level would need one stack per level, so jobs of all
+ * priorities share it, at the priority of the dispatcher: the gcd of the job periods
+ * and phases under RMS, the tightest job deadline under DMS. The response time
+ * analysis charges the dispatcher for the jobs it runs and checks every job against
+ * its own deadline; a due job may wait for one lower priority job that has already
+ * started. WCET overruns and deadline misses are flagged per job and reported by the
+ * scheduler task. A job is never deleted, as that would abort the jobs sharing its
+ * stack, and the dispatcher is exempt from the timing error detection. */
+#define schedUSE_PERIODIC_JOBS 1
+
+#if( schedUSE_PERIODIC_JOBS == 1 )
+	/* Maximum number of periodic jobs that can be created. Each one costs 18 bytes of
+	 * static RAM. */
+	#define schedMAX_NUMBER_OF_PERIODIC_JOBS 24
+	/* Stack size of the job dispatcher task, shared by all jobs. */
+	#define schedJOB_DISPATCHER_STACK_SIZE configMINIMAL_STACK_SIZE
+#endif /* schedUSE_PERIODIC_JOBS */
+
+/* Set this define to 1 to allow the period, deadline and WCET of a periodic task to
+ * change while the scheduler runs. The change takes effect at the next release of the
+ * task, where RMS/DMS priorities, preemption thresholds and resource ceilings of the
+ * whole task set are assigned again. */
+#define schedUSE_TIMING_CHANGES 1
+
+/* Set this define to 1 to enable dual priority scheduling. Each job of a periodic
+ * task starts in a lower band below background work and is promoted to its normal
+ * priority D - R ticks after its release, where R is its response time. Background
+ * and aperiodic work created with xTaskCreate() at schedDUAL_PRIORITY_BACKGROUND_PRIORITY
+ * thus runs ahead of periodic jobs while they have slack, and deadlines are still met.
+ * Tasks with a CBS reservation, the sporadic server and tasks without slack always run
+ * in the upper band. The two bands take two priorities below the periodic tasks, so
+ * this is off by default. Requires the scheduler task. */
+#define schedUSE_DUAL_PRIORITY 0
+
+#if( schedUSE_DUAL_PRIORITY == 1 )
+	/* Priority of periodic jobs before their promotion. */
+	#define schedDUAL_PRIORITY_LOWER_BAND ( tskIDLE_PRIORITY + 1 )
+	/* Priority for background tasks. Every periodic task must have a higher priority. */
+	#define schedDUAL_PRIORITY_BACKGROUND_PRIORITY ( tskIDLE_PRIORITY + 2 )
+#endif /* schedUSE_DUAL_PRIORITY */
+
+/* Set this define to 1 to enable (m,k)-firm tasks, which tolerate at most m deadline
+ * misses in any k consecutive jobs. A tolerated miss lets the job run to completion
+ * instead of recreating the task. Releases follow the deeply-red pattern: the first
+ * k - m jobs of every window of k releases are mandatory, the last m are optional.
+ * When the previous job of a task missed its deadline or was skipped, its optional
+ * jobs are skipped as long as the skipped job, counted as a miss, keeps the
+ * constraint. Only the task's own history decides, so an overrun of one task does not
+ * use up the budgets of others. The task is recreated only on a miss that would
+ * violate the constraint. Requires the scheduler task and deadline detection. */
+#define schedUSE_MK_FIRM 1
+
+/* Set this define to 1 to enable elastic tasks. The scheduler task observes the
+ * execution times of all periodic tasks and, when their utilisation exceeds
+ * schedELASTIC_UTILISATION_BOUND, stretches the periods of elastic tasks in
+ * proportion to their elastic coefficients. Periods return towards their minimum
+ * when the load drops. Requires the scheduler task and schedUSE_TIMING_CHANGES. */
+#define schedUSE_ELASTIC_TASKS 1
+
+#if( schedUSE_ELASTIC_TASKS == 1 )
+	/* Utilisation bound scaled to 1024, by default ln 2 for RMS/DMS. */
+	#define schedELASTIC_UTILISATION_BOUND 710UL
+	/* Change of the observed load, scaled to 1024, after which periods are computed again. */
+	#define schedELASTIC_LOAD_HYSTERESIS 16UL
+#endif /* schedUSE_ELASTIC_TASKS */
+
+/* Set this define to 1 to enable mixed-criticality scheduling after the AMC scheme.
+ * HI tasks have a LO and a HI budget, LO tasks a LO budget only. A HI task that
+ * overruns its LO budget switches the system to HI mode, where LO tasks are suspended
+ * and HI tasks are supervised against their HI budget. The system returns to LO mode
+ * at the next idle instant, and LO tasks restart at their next period boundary. The
+ * response-time analysis includes the AMC-rtb test of HI tasks.
+ * Requires the scheduler task and WCET supervision. */
+#define schedUSE_MIXED_CRITICALITY 1
+
+#if( schedUSE_MIXED_CRITICALITY == 1 )
+	#define schedCRITICALITY_LO 0
+	#define schedCRITICALITY_HI 1
+#endif /* schedUSE_MIXED_CRITICALITY */
+
+/* Set this define to 1 to enable operating modes. Every periodic task belongs to a set
+ * of modes, all modes by default. On a mode change, tasks that are not part of the new
+ * mode retire at their next release. Once all of them have retired, tasks of the new
+ * mode are released at the next idle instant, each after its phase. Retiring tasks
+ * thus finish their last job before new load arrives. Requires the scheduler task. */
+#define schedUSE_MODES 1
+
+#if( schedUSE_MODES == 1 )
+	/* Maximum number of modes, at most the number of bits in UBaseType_t. */
+	#define schedMAX_NUMBER_OF_MODES 8
+	/* Mode mask of a task that belongs to every mode. */
+	#define schedALL_MODES ( ( UBaseType_t ) ~( UBaseType_t ) 0 )
+#endif /* schedUSE_MODES */
+
+/* Set this define to 1 to enable sporadic tasks, which are released from interrupts
+ * instead of by the tick. Releases closer together than the minimum inter-arrival
+ * time are deferred, so priorities and the timing supervision treat the task like a
+ * periodic task whose period is that minimum. */
+#define schedUSE_SPORADIC_TASKS 1
+
+/* Set this define to 1 to enable a sporadic server for aperiodic jobs. The server is
+ * scheduled like a periodic task with its budget as WCET and its period as deadline.
+ * Execution time of the server is taken from its budget, and each consumed chunk is
+ * given back one server period after the server became active. The server is
+ * suspended while its budget is exhausted. Aperiodic jobs should not hold resources
+ * across a budget exhaustion. Requires the scheduler task. */
+#define schedUSE_SPORADIC_SERVER 1
+
+#if( schedUSE_SPORADIC_SERVER == 1 )
+	/* Maximum number of pending replenishments. Further ones are merged into the last. */
+	#define schedSPORADIC_SERVER_MAX_REPLENISHMENTS 4
+#endif /* schedUSE_SPORADIC_SERVER */
+
+/* Set this define to 1 to enable preemption-threshold scheduling. While a job runs,
+ * its task executes at its preemption threshold, so only tasks with a priority at or
+ * above the threshold can preempt it, the latter through time slicing. With
+ * schedUSE_DEBUG_PRINTS the response-time analysis of the task set is printed when the
+ * scheduler starts. Every task keeps a stack of its own. */
+#define schedUSE_PREEMPTION_THRESHOLDS 1
+
+#if( schedUSE_PREEMPTION_THRESHOLDS == 1 )
+	/* Set this define to 1 to raise the threshold of every task that has no explicit
+	 * threshold as far as the task set stays schedulable. */
+	#define schedAUTO_ASSIGN_PREEMPTION_THRESHOLDS 1
+#endif /* schedUSE_PREEMPTION_THRESHOLDS */
+
+/* Set this define to 1 to fall back to Audsley's optimal priority assignment when
+ * the RMS/DMS priorities fail the response-time analysis at vSchedulerStart(), e.g.
+ * for deadlines longer than periods or unequal blocking. Each task then gets a
+ * priority of its own, so there can be at most schedSCHEDULER_PRIORITY periodic
+ * tasks. Automatic preemption thresholds are cleared for the search and assigned
+ * again after it; the order is only guaranteed to be found when no task has a
+ * threshold set with vSchedulerPeriodicTaskSetPreemptionThreshold(). */
+#define schedUSE_OPTIMAL_PRIORITY_ASSIGNMENT 1
+
+/* Set this define to 1 to share resources under the Stack Resource Policy. Every
+ * periodic task gets a preemption level from its relative deadline and every declared
+ * resource a ceiling, the highest level among its users. xTaskResourceTake() raises the
+ * caller above every task whose level does not exceed the ceiling. A job of a resource
+ * user starts only when its level exceeds the ceilings of all held resources and the
+ * levels of all other started jobs of resource users, which also covers tasks of equal
+ * priority that are time sliced in. A job can thus only be blocked before it starts and
+ * never while it holds part of a shared stack. Resources may be given back in any order. */
+#define schedUSE_SRP 1
+
+/* Resources declared with vSchedulerPeriodicTaskDeclareResource() get their ceilings
+ * derived from their users, under SRP or otherwise under the priority ceiling protocol
+ * of the kernel. Ceilings are derived again whenever task priorities change. */
+#if( schedUSE_SRP == 1 || configUSE_PRIORITY_CEILING_PROTOCOL == 1 )
+	#define schedUSE_RESOURCE_DECLARATIONS 1
+	/* Maximum number of resources that can be declared. */
+	#define schedMAX_NUMBER_OF_RESOURCES 5
+#else
+	#define schedUSE_RESOURCE_DECLARATIONS 0
+#endif /* schedUSE_SRP || configUSE_PRIORITY_CEILING_PROTOCOL */
+
+/* Set this define to 1 to enable Constant Bandwidth Server reservations for soft
+ * periodic tasks. A soft task may execute for its budget per server period at its
+ * RMS/DMS priority. When the budget runs out the server deadline is postponed by one
+ * server period and the task continues at background priority until the old deadline
+ * instead of being deleted, so overruns do not reach hard tasks. A soft task is not
+ * subject to WCET and deadline supervision, and should not hold resources under SRP.
+ * Requires the scheduler task. */
+#define schedUSE_CBS 1
+
+/* Set this define to 1 to release periodic jobs from a release calendar owned by the
+ * scheduler instead of a xTaskDelayUntil() per task. Waiting tasks are kept sorted by
+ * their next release, and the tick hook releases every job due at a tick in one pass
+ * with a task notification. The delay between the release of a job and its start is
+ * recorded as release jitter. Requires the scheduler task. */
+#define schedUSE_RELEASE_CALENDAR 1
+
+/* Set this define to 1 to enable the telemetry API, which reports the stack
+ * high-water mark of every periodic task and the state of the heap. */
+#define schedUSE_TELEMETRY 1
+
+#if( schedUSE_TELEMETRY == 1 )
+	/* Set this define to 1 to let the task set run for schedCALIBRATION_HYPERPERIODS
+	 * hyperperiods and then print the recommended stack size of every periodic task.
+	 * Requires the scheduler task. */
+	#define schedUSE_STACK_CALIBRATION 0
+	/* Number of hyperperiods observed before recommendations are printed. */
+	#define schedCALIBRATION_HYPERPERIODS 4
+	/* Margin in words added to the deepest stack usage observed during calibration. */
+	#define schedSTACK_CALIBRATION_MARGIN 24
+
+	/* Stack usage of a periodic task. */
+	typedef struct xSCHED_TASK_TELEMETRY
+	{
+		const char *pcName;								/* Name of the task. */
+		configSTACK_DEPTH_TYPE uxStackDepth;			/* Stack size given at creation, in words. */
+		configSTACK_DEPTH_TYPE uxStackHighWaterMark;	/* Least free stack ever observed, in words. */
+		configSTACK_DEPTH_TYPE uxRecommendedStackDepth;	/* Deepest observed usage plus schedSTACK_CALIBRATION_MARGIN. */
+		#if( schedUSE_RELEASE_CALENDAR == 1 )
+			TickType_t xMaxReleaseJitter;				/* Longest delay from a release to the start of its job, in ticks. */
+		#endif /* schedUSE_RELEASE_CALENDAR */
+	} SchedTaskTelemetry_t;
+
+	/* State of the heap used by pvPortMalloc(). */
+	typedef struct xSCHED_HEAP_TELEMETRY
+	{
+		size_t xFreeBytes;					/* Bytes currently free. */
+		size_t xMinimumEverFreeBytes;		/* Least number of free bytes since boot. */
+		size_t xLargestFreeBlock;			/* Largest single allocation that can currently succeed. */
+		UBaseType_t uxFragmentationPercent;	/* Share of free bytes that are not part of the largest free block. */
+	} SchedHeapTelemetry_t;
+#endif /* schedUSE_TELEMETRY */
+
 /* This function must be called before any other function call from scheduler.h. */
 void vSchedulerInit( void );
 
@@ -80,9 +303,123 @@ void vSchedulerInit( void );
  * xMaxExecTimeTick: Worst-case execution time given in software ticks.
  * xDeadlineTick: Relative deadline given in software ticks.
  * */
-void vSchedulerPeriodicTaskCreate( TaskFunction_t pvTaskCode, const char *pcName, UBaseType_t uxStackDepth, void *pvParameters, UBaseType_t uxPriority,
+void vSchedulerPeriodicTaskCreate( TaskFunction_t pvTaskCode, const char *pcName, configSTACK_DEPTH_TYPE uxStackDepth, void *pvParameters, UBaseType_t uxPriority,
 		TaskHandle_t *pxCreatedTask, TickType_t xPhaseTick, TickType_t xPeriodTick, TickType_t xMaxExecTimeTick, TickType_t xDeadlineTick );
 
+#if( schedUSE_PERIODIC_JOBS == 1 )
+	/* Creates a periodic run-to-completion job. The job function is called once per
+	 * period and must return without blocking. Jobs run non-preemptively with respect
+	 * to each other on the shared stack of the job dispatcher task, which occupies one
+	 * periodic task slot once at least one job exists. Parameters have the same meaning
+	 * as for vSchedulerPeriodicTaskCreate(). */
+	void vSchedulerPeriodicJobCreate( TaskFunction_t pvJobCode, const char *pcName, void *pvParameters,
+			TickType_t xPhaseTick, TickType_t xPeriodTick, TickType_t xMaxExecTimeTick, TickType_t xDeadlineTick );
+#endif /* schedUSE_PERIODIC_JOBS */
+
+#if( schedUSE_SPORADIC_TASKS == 1 )
+	/* Creates a sporadic task. A job is released by every call to
+	 * xSchedulerSporadicTaskReleaseFromISR(), but never earlier than
+	 * xMinInterArrivalTick after the previous release. Other parameters have the same
+	 * meaning as for vSchedulerPeriodicTaskCreate(). */
+	void vSchedulerSporadicTaskCreate( TaskFunction_t pvTaskCode, const char *pcName, configSTACK_DEPTH_TYPE uxStackDepth, void *pvParameters, UBaseType_t uxPriority,
+			TaskHandle_t *pxCreatedTask, TickType_t xMinInterArrivalTick, TickType_t xMaxExecTimeTick, TickType_t xDeadlineTick );
+
+	/* Releases a job of a sporadic task from an interrupt. Returns pdFAIL if a release
+	 * is already pending, in which case both events are served by the same job. */
+	BaseType_t xSchedulerSporadicTaskReleaseFromISR( TaskHandle_t xTaskHandle, BaseType_t *pxHigherPriorityTaskWoken );
+#endif /* schedUSE_SPORADIC_TASKS */
+
+#if( schedUSE_SPORADIC_SERVER == 1 )
+	/* Creates the sporadic server. It occupies one periodic task slot.
+	 * uxQueueLength: Number of aperiodic jobs that can wait for the server.
+	 * xPeriodTick: Replenishment period of the server given in software ticks.
+	 * xBudgetTick: Execution time available to aperiodic jobs per period given in software ticks.
+	 * */
+	void vSchedulerSporadicServerCreate( configSTACK_DEPTH_TYPE uxStackDepth, UBaseType_t uxQueueLength, TickType_t xPeriodTick, TickType_t xBudgetTick );
+
+	/* Queues an aperiodic job for the sporadic server. pvJobCode is called once with
+	 * pvParameters. Returns pdFAIL if the queue stayed full for xTicksToWait. */
+	BaseType_t xSchedulerAperiodicJobSubmit( TaskFunction_t pvJobCode, void *pvParameters, TickType_t xTicksToWait );
+
+	/* Interrupt safe version of xSchedulerAperiodicJobSubmit(). */
+	BaseType_t xSchedulerAperiodicJobSubmitFromISR( TaskFunction_t pvJobCode, void *pvParameters, BaseType_t *pxHigherPriorityTaskWoken );
+#endif /* schedUSE_SPORADIC_SERVER */
+
+#if( schedUSE_PREEMPTION_THRESHOLDS == 1 )
+	/* Sets the preemption threshold of a periodic task. pxCreatedTask is the pointer
+	 * that was passed to vSchedulerPeriodicTaskCreate(). Must be called before
+	 * vSchedulerStart(). A threshold below the priority assigned by RMS/DMS is raised
+	 * to that priority. */
+	void vSchedulerPeriodicTaskSetPreemptionThreshold( TaskHandle_t *pxCreatedTask, UBaseType_t uxThreshold );
+#endif /* schedUSE_PREEMPTION_THRESHOLDS */
+
+#if( schedUSE_CBS == 1 )
+	/* Makes the periodic task created with pxCreatedTask a soft task served by a
+	 * Constant Bandwidth Server with budget xBudgetTick per xServerPeriodTick. The budget
+	 * replaces the WCET in priority assignment and analysis, which holds for the other
+	 * tasks when the server period equals the task period. Must be called before
+	 * vSchedulerStart(). */
+	void vSchedulerPeriodicTaskSetReservation( TaskHandle_t *pxCreatedTask, TickType_t xBudgetTick, TickType_t xServerPeriodTick );
+#endif /* schedUSE_CBS */
+
+#if( schedUSE_RESOURCE_DECLARATIONS == 1 )
+	/* Declares that the periodic task created with pxCreatedTask takes xSemaphore
+	 * through xTaskResourceTake(). Must be called before vSchedulerStart(). */
+	void vSchedulerPeriodicTaskDeclareResource( TaskHandle_t *pxCreatedTask, SemaphoreHandle_t xSemaphore );
+#endif /* schedUSE_RESOURCE_DECLARATIONS */
+
+#if( schedUSE_MIXED_CRITICALITY == 1 )
+	/* Sets the criticality of a periodic task. The WCET given at creation is the LO
+	 * budget; xHiMaxExecTimeTick is the HI budget and must not be smaller. Must be
+	 * called before vSchedulerStart(). */
+	void vSchedulerPeriodicTaskSetCriticality( TaskHandle_t *pxCreatedTask, BaseType_t xCriticality, TickType_t xHiMaxExecTimeTick );
+
+	/* Returns schedCRITICALITY_HI while LO tasks are dropped, schedCRITICALITY_LO otherwise. */
+	BaseType_t xSchedulerGetCriticality( void );
+#endif /* schedUSE_MIXED_CRITICALITY */
+
+#if( schedUSE_MODES == 1 )
+	/* Creates a mode and returns its number. The first mode created is mode 0, which is
+	 * the initial mode unless xSchedulerModeChange() is called before vSchedulerStart(). */
+	BaseType_t xSchedulerModeCreate( const char *pcName );
+
+	/* Sets the modes a periodic task belongs to, bit n standing for mode n. Must be
+	 * called before vSchedulerStart(). */
+	void vSchedulerPeriodicTaskSetModes( TaskHandle_t *pxCreatedTask, UBaseType_t uxModeMask );
+
+	/* Requests a change to xMode. Returns pdFAIL if another mode change is in progress. */
+	BaseType_t xSchedulerModeChange( BaseType_t xMode );
+
+	/* Returns the current mode. During a mode change this is still the old mode. */
+	BaseType_t xSchedulerGetMode( void );
+
+	/* Returns the name given to xMode. */
+	const char *pcSchedulerGetModeName( BaseType_t xMode );
+#endif /* schedUSE_MODES */
+
+#if( schedUSE_TIMING_CHANGES == 1 )
+	/* Changes the timing parameters of a periodic task, given in software ticks. The
+	 * current job keeps its old parameters; the next release still happens one old
+	 * period after the current one and is the first to use the new values. Returns
+	 * pdFAIL and changes nothing unless 0 < xPeriodTick, xDeadlineTick <= xPeriodTick
+	 * and xMaxExecTimeTick <= xDeadlineTick. */
+	BaseType_t xSchedulerPeriodicTaskSetTiming( TaskHandle_t xTaskHandle, TickType_t xPeriodTick, TickType_t xDeadlineTick, TickType_t xMaxExecTimeTick );
+#endif /* schedUSE_TIMING_CHANGES */
+
+#if( schedUSE_MK_FIRM == 1 )
+	/* Lets a periodic task miss at most uxMaxMisses deadlines in any uxWindow
+	 * consecutive jobs, with uxWindow at most 16. Must be called before vSchedulerStart(). */
+	void vSchedulerPeriodicTaskSetMKFirm( TaskHandle_t *pxCreatedTask, UBaseType_t uxMaxMisses, UBaseType_t uxWindow );
+#endif /* schedUSE_MK_FIRM */
+
+#if( schedUSE_ELASTIC_TASKS == 1 )
+	/* Makes a periodic task elastic with the given elastic coefficient. The task runs at
+	 * xMinPeriodTick while the load allows it and is never stretched beyond
+	 * xMaxPeriodTick. The deadline given at creation is scaled with the period. Must be
+	 * called before vSchedulerStart(). */
+	void vSchedulerPeriodicTaskSetElastic( TaskHandle_t *pxCreatedTask, UBaseType_t uxElasticity, TickType_t xMinPeriodTick, TickType_t xMaxPeriodTick );
+#endif /* schedUSE_ELASTIC_TASKS */
+
 /* Deletes a periodic task associated with the given task handle. */
 void vSchedulerPeriodicTaskDelete( TaskHandle_t xTaskHandle );
 
@@ -95,6 +432,19 @@ BaseType_t xTaskResourceGive( SemaphoreHandle_t xSemaphore );
 /* Starts scheduling tasks. */
 void vSchedulerStart( void );
 
+#if( schedUSE_TELEMETRY == 1 )
+	/* Fills pxTelemetry with the stack usage and release jitter of the periodic task
+	 * associated with the given task handle. Returns pdFAIL if the handle is not a periodic task. */
+	BaseType_t xSchedulerGetTaskTelemetry( TaskHandle_t xTaskHandle, SchedTaskTelemetry_t *pxTelemetry );
+
+	/* Fills pxTelemetry with the current state of the heap. */
+	void vSchedulerGetHeapTelemetry( SchedHeapTelemetry_t *pxTelemetry );
+
+	/* Prints stack usage of all periodic tasks and of the scheduler task, and heap usage,
+	 * on the serial port. */
+	void vSchedulerPrintTelemetry( void );
+#endif /* schedUSE_TELEMETRY */
+
 #ifdef __cplusplus
 }
 #endif
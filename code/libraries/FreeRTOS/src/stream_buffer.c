@@ -133,6 +133,13 @@
 /* Bits stored in the ucFlags field of the stream buffer. */
 #define sbFLAGS_IS_MESSAGE_BUFFER          ( ( uint8_t ) 1 ) /* Set if the stream buffer was created as a message buffer, in which case it holds discrete messages rather than a stream. */
 #define sbFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 2 ) /* Set if the stream buffer was created using statically allocated memory. */
+#define sbFLAGS_IS_MULTI_PRODUCER          ( ( uint8_t ) 4 ) /* Set if several tasks and interrupts may write to the buffer at once. */
+
+#if ( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+    #if ( configSTREAM_BUFFER_MAX_RESERVATIONS > 8 )
+        #error configSTREAM_BUFFER_MAX_RESERVATIONS must not be more than 8, one bit per reservation in ucReservationsCommitted
+    #endif
+#endif
 
 /*-----------------------------------------------------------*/
 
@@ -151,6 +158,14 @@ typedef struct StreamBufferDef_t                 /*lint !e9058 Style convention
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxStreamBufferNumber; /* Used for tracing purposes. */
     #endif
+
+    #if ( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+        volatile size_t xReservedHead;                                          /* Index after the last byte reserved by a writer.  xHead only catches up as reservations are committed, oldest first. */
+        size_t xReservationEnd[ configSTREAM_BUFFER_MAX_RESERVATIONS ];         /* Where xHead moves to when each outstanding reservation is committed. */
+        uint8_t ucOldestReservation;                                            /* Index into xReservationEnd[] of the oldest outstanding reservation. */
+        uint8_t ucReservations;                                                 /* Number of outstanding reservations. */
+        volatile uint8_t ucReservationsCommitted;                               /* Bit n set if reservation n is written but waiting for an older one. */
+    #endif
 } StreamBuffer_t;
 
 /*
@@ -159,14 +174,71 @@ typedef struct StreamBufferDef_t                 /*lint !e9058 Style convention
 static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
 
 /*
- * Add xCount bytes from pucData into the pxStreamBuffer message buffer.
- * Returns the number of bytes written, which will either equal xCount in the
- * success case, or 0 if there was not enough space in the buffer (in which case
- * no data is written into the buffer).
+ * Blocks the calling task for up to xTicksToWait ticks until at least
+ * xRequiredSpace bytes are free, then returns the space available, which is
+ * less than xRequiredSpace if the wait timed out.
+ */
+static size_t prvWaitForSpace( StreamBuffer_t * const pxStreamBuffer,
+                               size_t xRequiredSpace,
+                               TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Blocks the calling task for up to xTicksToWait ticks until more than
+ * xBytesToStoreMessageLength bytes are in the buffer, then returns the number
+ * of bytes in the buffer.
+ */
+static size_t prvWaitForData( StreamBuffer_t * const pxStreamBuffer,
+                              size_t xBytesToStoreMessageLength,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+
+/*
+ * Writes to a multi-producer buffer.  The space is reserved, and then the
+ * reservation committed, inside two short critical sections; the data is
+ * copied between them with interrupts enabled, so interrupts can reserve and
+ * fill their own space meanwhile.  Tasks call it with the scheduler suspended.
+ * Never blocks.  Returns pdTRUE in *pxShouldNotify if the reader should be
+ * notified.
+ */
+    static size_t prvSendMultiProducer( StreamBuffer_t * const pxStreamBuffer,
+                                        const void * pvTxData,
+                                        size_t xDataLengthBytes,
+                                        BaseType_t xFromISR,
+                                        BaseType_t * const pxShouldNotify ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+/*
+ * Describes xCount bytes of the buffer starting at index xStart, which may be
+ * up to one buffer length past the end, as one or two spans.
+ */
+    static void prvGetSpans( const StreamBuffer_t * const pxStreamBuffer,
+                             size_t xStart,
+                             size_t xCount,
+                             StreamBufferSpans_t * const pxSpans ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move xHead past bytes written in place, and xTail past bytes read in place.
+ * Both return pdTRUE if the task waiting on the other end should be notified.
+ */
+    static BaseType_t prvCommitWrite( StreamBuffer_t * const pxStreamBuffer,
+                                      size_t xBytesWritten ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvConsumeRead( StreamBuffer_t * const pxStreamBuffer,
+                                      size_t xBytesConsumed ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Copy xCount bytes from pucData into the pxStreamBuffer storage area starting
+ * at index xHead, wrapping as necessary.  Returns the index after the last byte
+ * written.  The caller has already checked there is space, and updates the
+ * buffer's own xHead when the bytes are to become visible.
  */
 static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
                                      const uint8_t * pucData,
-                                     size_t xCount ) PRIVILEGED_FUNCTION;
+                                     size_t xCount,
+                                     size_t xHead ) PRIVILEGED_FUNCTION;
 
 /*
  * If the stream buffer is being used as a message buffer, then reads an entire
@@ -228,7 +300,7 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
          * (that is, it will hold discrete messages with a little meta data that
          * says how big the next message is) check the buffer will be large enough
          * to hold at least one message. */
-        if( xIsMessageBuffer == pdTRUE )
+        if( ( xIsMessageBuffer & sbTYPE_MESSAGE_BUFFER ) != 0 )
         {
             /* Is a message buffer but not statically allocated. */
             ucFlags = sbFLAGS_IS_MESSAGE_BUFFER;
@@ -241,6 +313,13 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
             configASSERT( xBufferSizeBytes > 0 );
         }
 
+        #if ( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+            if( ( xIsMessageBuffer & sbTYPE_MULTI_PRODUCER ) != 0 )
+            {
+                ucFlags |= sbFLAGS_IS_MULTI_PRODUCER;
+            }
+        #endif
+
         configASSERT( xTriggerLevelBytes <= xBufferSizeBytes );
 
         /* A trigger level of 0 would cause a waiting task to unblock even when
@@ -313,7 +392,7 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
             xTriggerLevelBytes = ( size_t ) 1;
         }
 
-        if( xIsMessageBuffer != pdFALSE )
+        if( ( xIsMessageBuffer & sbTYPE_MESSAGE_BUFFER ) != 0 )
         {
             /* Statically allocated message buffer. */
             ucFlags = sbFLAGS_IS_MESSAGE_BUFFER | sbFLAGS_IS_STATICALLY_ALLOCATED;
@@ -324,6 +403,13 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
             ucFlags = sbFLAGS_IS_STATICALLY_ALLOCATED;
         }
 
+        #if ( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+            if( ( xIsMessageBuffer & sbTYPE_MULTI_PRODUCER ) != 0 )
+            {
+                ucFlags |= sbFLAGS_IS_MULTI_PRODUCER;
+            }
+        #endif
+
         /* In case the stream buffer is going to be used as a message buffer
          * (that is, it will hold discrete messages with a little meta data that
          * says how big the next message is) check the buffer will be large enough
@@ -488,7 +574,19 @@ size_t xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer )
     configASSERT( pxStreamBuffer );
 
     xSpace = pxStreamBuffer->xLength + pxStreamBuffer->xTail;
-    xSpace -= pxStreamBuffer->xHead;
+
+    #if ( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 )
+        {
+            /* Space reserved by a writer is not free even before it is
+             * committed. */
+            xSpace -= pxStreamBuffer->xReservedHead;
+        }
+        else
+    #endif /* configUSE_STREAM_BUFFER_MULTI_PRODUCER */
+    {
+        xSpace -= pxStreamBuffer->xHead;
+    }
     xSpace -= ( size_t ) 1;
 
     if( xSpace >= pxStreamBuffer->xLength )
@@ -522,9 +620,8 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
                           TickType_t xTicksToWait )
 {
     StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
-    size_t xReturn, xSpace = 0;
+    size_t xReturn, xSpace;
     size_t xRequiredSpace = xDataLengthBytes;
-    TimeOut_t xTimeOut;
 
     /* The maximum amount of space a stream buffer will ever report is its length
      * minus 1. */
@@ -533,6 +630,37 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
     configASSERT( pvTxData );
     configASSERT( pxStreamBuffer );
 
+    #if ( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 )
+        {
+            BaseType_t xShouldNotify;
+
+            /* Only one task can wait on the buffer's send side, so writers to
+             * a shared buffer do not block. */
+            ( void ) xTicksToWait;
+
+            /* A task preempted mid-copy would hold back every send reserved
+             * after its own until it ran again, so no other task runs until it
+             * has committed.  Interrupts still run. */
+            vTaskSuspendAll();
+            {
+                xReturn = prvSendMultiProducer( pxStreamBuffer, pvTxData, xDataLengthBytes, pdFALSE, &xShouldNotify );
+            }
+            ( void ) xTaskResumeAll();
+
+            if( xShouldNotify != pdFALSE )
+            {
+                sbSEND_COMPLETED( pxStreamBuffer );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return xReturn;
+        }
+    #endif /* configUSE_STREAM_BUFFER_MULTI_PRODUCER */
+
     /* This send function is used to write to both message buffers and stream
      * buffers.  If this is a message buffer then the space needed must be
      * increased by the amount of bytes needed to store the length of the
@@ -572,53 +700,7 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         }
     }
 
-    if( xTicksToWait != ( TickType_t ) 0 )
-    {
-        vTaskSetTimeOutState( &xTimeOut );
-
-        do
-        {
-            /* Wait until the required number of bytes are free in the message
-             * buffer. */
-            taskENTER_CRITICAL();
-            {
-                xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
-
-                if( xSpace < xRequiredSpace )
-                {
-                    /* Clear notification state as going to wait for space. */
-                    ( void ) xTaskNotifyStateClear( NULL );
-
-                    /* Should only be one writer. */
-                    configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
-                    pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
-                }
-                else
-                {
-                    taskEXIT_CRITICAL();
-                    break;
-                }
-            }
-            taskEXIT_CRITICAL();
-
-            traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
-            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
-            pxStreamBuffer->xTaskWaitingToSend = NULL;
-        } while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
-    }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
-
-    if( xSpace == ( size_t ) 0 )
-    {
-        xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
-    }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
+    xSpace = prvWaitForSpace( pxStreamBuffer, xRequiredSpace, xTicksToWait );
 
     xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
 
@@ -658,6 +740,28 @@ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
     configASSERT( pvTxData );
     configASSERT( pxStreamBuffer );
 
+    #if ( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 )
+        {
+            BaseType_t xShouldNotify;
+
+            xReturn = prvSendMultiProducer( pxStreamBuffer, pvTxData, xDataLengthBytes, pdTRUE, &xShouldNotify );
+
+            if( xShouldNotify != pdFALSE )
+            {
+                sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+            return xReturn;
+        }
+    #endif /* configUSE_STREAM_BUFFER_MULTI_PRODUCER */
+
     /* This send function is used to write to both message buffers and stream
      * buffers.  If this is a message buffer then the space needed must be
      * increased by the amount of bytes needed to store the length of the
@@ -697,6 +801,174 @@ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+
+    static size_t prvSendMultiProducer( StreamBuffer_t * const pxStreamBuffer,
+                                        const void * pvTxData,
+                                        size_t xDataLengthBytes,
+                                        BaseType_t xFromISR,
+                                        BaseType_t * const pxShouldNotify )
+    {
+        UBaseType_t uxSavedInterruptStatus = 0;
+        size_t xSpace, xRequiredSpace = xDataLengthBytes, xStart = 0, xNextHead;
+        uint8_t ucReservation = 0;
+        BaseType_t xIsMessageBuffer = ( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 ) ? pdTRUE : pdFALSE;
+
+        *pxShouldNotify = pdFALSE;
+
+        if( xIsMessageBuffer != pdFALSE )
+        {
+            xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+            configASSERT( xRequiredSpace > xDataLengthBytes );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Reserve the space.  A whole message or nothing is reserved for a
+         * message buffer, as many bytes as fit for a stream buffer. */
+        if( xFromISR != pdFALSE )
+        {
+            uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+        }
+        else
+        {
+            taskENTER_CRITICAL();
+        }
+
+        {
+            xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+            if( pxStreamBuffer->ucReservations >= ( uint8_t ) configSTREAM_BUFFER_MAX_RESERVATIONS )
+            {
+                xRequiredSpace = 0;
+            }
+            else if( xIsMessageBuffer != pdFALSE )
+            {
+                if( xSpace < xRequiredSpace )
+                {
+                    xRequiredSpace = 0;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                xRequiredSpace = configMIN( xRequiredSpace, xSpace );
+                xDataLengthBytes = xRequiredSpace;
+            }
+
+            if( xRequiredSpace > ( size_t ) 0 )
+            {
+                xStart = pxStreamBuffer->xReservedHead;
+                xNextHead = xStart + xRequiredSpace;
+
+                if( xNextHead >= pxStreamBuffer->xLength )
+                {
+                    xNextHead -= pxStreamBuffer->xLength;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxStreamBuffer->xReservedHead = xNextHead;
+
+                ucReservation = ( uint8_t ) ( ( pxStreamBuffer->ucOldestReservation + pxStreamBuffer->ucReservations ) % ( uint8_t ) configSTREAM_BUFFER_MAX_RESERVATIONS );
+                pxStreamBuffer->xReservationEnd[ ucReservation ] = xNextHead;
+                pxStreamBuffer->ucReservationsCommitted &= ( uint8_t ) ~( 1U << ucReservation );
+                pxStreamBuffer->ucReservations++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        if( xFromISR != pdFALSE )
+        {
+            portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        }
+        else
+        {
+            taskEXIT_CRITICAL();
+        }
+
+        if( xRequiredSpace == ( size_t ) 0 )
+        {
+            traceSTREAM_BUFFER_SEND_FAILED( pxStreamBuffer );
+            return 0;
+        }
+
+        /* Fill the reservation.  Nobody else writes to it, and the reader does
+         * not see it until xHead moves past it. */
+        if( xIsMessageBuffer != pdFALSE )
+        {
+            xStart = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xDataLengthBytes ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xStart );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        ( void ) prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes, xStart ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alignment and access. */
+
+        /* Commit it.  xHead moves past every committed reservation up to the
+         * first still being written, so data is seen in the order the space was
+         * reserved and never with a gap. */
+        if( xFromISR != pdFALSE )
+        {
+            uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+        }
+        else
+        {
+            taskENTER_CRITICAL();
+        }
+
+        {
+            pxStreamBuffer->ucReservationsCommitted |= ( uint8_t ) ( 1U << ucReservation );
+
+            while( ( pxStreamBuffer->ucReservations > ( uint8_t ) 0 ) &&
+                   ( ( pxStreamBuffer->ucReservationsCommitted & ( uint8_t ) ( 1U << pxStreamBuffer->ucOldestReservation ) ) != ( uint8_t ) 0 ) )
+            {
+                pxStreamBuffer->xHead = pxStreamBuffer->xReservationEnd[ pxStreamBuffer->ucOldestReservation ];
+                pxStreamBuffer->ucReservationsCommitted &= ( uint8_t ) ~( 1U << pxStreamBuffer->ucOldestReservation );
+                pxStreamBuffer->ucOldestReservation = ( uint8_t ) ( ( pxStreamBuffer->ucOldestReservation + 1U ) % ( uint8_t ) configSTREAM_BUFFER_MAX_RESERVATIONS );
+                pxStreamBuffer->ucReservations--;
+                *pxShouldNotify = pdTRUE;
+            }
+
+            /* Was a task waiting for the data? */
+            if( ( *pxShouldNotify != pdFALSE ) && ( prvBytesInBuffer( pxStreamBuffer ) < pxStreamBuffer->xTriggerLevelBytes ) )
+            {
+                *pxShouldNotify = pdFALSE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        if( xFromISR != pdFALSE )
+        {
+            portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        }
+        else
+        {
+            taskEXIT_CRITICAL();
+        }
+
+        traceSTREAM_BUFFER_SEND( pxStreamBuffer, xDataLengthBytes );
+
+        return xDataLengthBytes;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_MULTI_PRODUCER */
+/*-----------------------------------------------------------*/
+
 static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
                                        const void * pvTxData,
                                        size_t xDataLengthBytes,
@@ -727,7 +999,7 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
          * into the buffer.  Start by writing the length of the data, the data
          * itself will be written later in this function. */
         xShouldWrite = pdTRUE;
-        ( void ) prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xDataLengthBytes ), sbBYTES_TO_STORE_MESSAGE_LENGTH );
+        pxStreamBuffer->xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xDataLengthBytes ), sbBYTES_TO_STORE_MESSAGE_LENGTH, pxStreamBuffer->xHead );
     }
     else
     {
@@ -738,7 +1010,8 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
     if( xShouldWrite != pdFALSE )
     {
         /* Writes the data itself. */
-        xReturn = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alignment and access. */
+        pxStreamBuffer->xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes, pxStreamBuffer->xHead ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alignment and access. */
+        xReturn = xDataLengthBytes;
     }
     else
     {
@@ -774,66 +1047,19 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
         xBytesToStoreMessageLength = 0;
     }
 
-    if( xTicksToWait != ( TickType_t ) 0 )
-    {
-        /* Checking if there is data and clearing the notification state must be
-         * performed atomically. */
-        taskENTER_CRITICAL();
-        {
-            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
-
-            /* If this function was invoked by a message buffer read then
-             * xBytesToStoreMessageLength holds the number of bytes used to hold
-             * the length of the next discrete message.  If this function was
-             * invoked by a stream buffer read then xBytesToStoreMessageLength will
-             * be 0. */
-            if( xBytesAvailable <= xBytesToStoreMessageLength )
-            {
-                /* Clear notification state as going to wait for data. */
-                ( void ) xTaskNotifyStateClear( NULL );
+    xBytesAvailable = prvWaitForData( pxStreamBuffer, xBytesToStoreMessageLength, xTicksToWait );
 
-                /* Should only be one reader. */
-                configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
-                pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
-        }
-        taskEXIT_CRITICAL();
+    /* Whether receiving a discrete message (where xBytesToStoreMessageLength
+     * holds the number of bytes used to store the message length) or a stream of
+     * bytes (where xBytesToStoreMessageLength is zero), the number of bytes
+     * available must be greater than xBytesToStoreMessageLength to be able to
+     * read bytes from the buffer. */
+    if( xBytesAvailable > xBytesToStoreMessageLength )
+    {
+        xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable, xBytesToStoreMessageLength );
 
-        if( xBytesAvailable <= xBytesToStoreMessageLength )
-        {
-            /* Wait for data to be available. */
-            traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
-            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
-            pxStreamBuffer->xTaskWaitingToReceive = NULL;
-
-            /* Recheck the data available after blocking. */
-            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-    }
-    else
-    {
-        xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
-    }
-
-    /* Whether receiving a discrete message (where xBytesToStoreMessageLength
-     * holds the number of bytes used to store the message length) or a stream of
-     * bytes (where xBytesToStoreMessageLength is zero), the number of bytes
-     * available must be greater than xBytesToStoreMessageLength to be able to
-     * read bytes from the buffer. */
-    if( xBytesAvailable > xBytesToStoreMessageLength )
-    {
-        xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable, xBytesToStoreMessageLength );
-
-        /* Was a task waiting for space in the buffer? */
-        if( xReceivedLength != ( size_t ) 0 )
+        /* Was a task waiting for space in the buffer? */
+        if( xReceivedLength != ( size_t ) 0 )
         {
             traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
             sbRECEIVE_COMPLETED( pxStreamBuffer );
@@ -1007,6 +1233,315 @@ static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+    size_t xStreamBufferAcquireWrite( StreamBufferHandle_t xStreamBuffer,
+                                      size_t xMaxBytes,
+                                      StreamBufferSpans_t * const pxSpans,
+                                      TickType_t xTicksToWait )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReturn, xSpace, xBytesToStoreMessageLength;
+        size_t xRequiredSpace = xMaxBytes;
+
+        /* The maximum amount of space a stream buffer will ever report is its
+         * length minus 1. */
+        const size_t xMaxReportedSpace = pxStreamBuffer->xLength - ( size_t ) 1;
+
+        configASSERT( pxStreamBuffer );
+        configASSERT( pxSpans );
+
+        /* Spans are handed out from xHead, so only to a single writer. */
+        configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) == ( uint8_t ) 0 );
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            /* Room is left in front of the spans for the message length, which
+             * is written when the message is committed. */
+            xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+            xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+            configASSERT( xRequiredSpace > xMaxBytes );
+
+            if( xRequiredSpace > xMaxReportedSpace )
+            {
+                xTicksToWait = ( TickType_t ) 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            xBytesToStoreMessageLength = 0;
+
+            if( xRequiredSpace > xMaxReportedSpace )
+            {
+                xRequiredSpace = xMaxReportedSpace;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        xSpace = prvWaitForSpace( pxStreamBuffer, xRequiredSpace, xTicksToWait );
+
+        if( xBytesToStoreMessageLength == ( size_t ) 0 )
+        {
+            xReturn = configMIN( xMaxBytes, xSpace );
+        }
+        else if( xSpace >= xRequiredSpace )
+        {
+            xReturn = xMaxBytes;
+        }
+        else
+        {
+            xReturn = 0;
+        }
+
+        prvGetSpans( pxStreamBuffer, pxStreamBuffer->xHead + xBytesToStoreMessageLength, xReturn, pxSpans );
+
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
+
+    void vStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer,
+                                   size_t xBytesWritten )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        configASSERT( pxStreamBuffer );
+
+        if( prvCommitWrite( pxStreamBuffer, xBytesWritten ) != pdFALSE )
+        {
+            sbSEND_COMPLETED( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+    void vStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+                                          size_t xBytesWritten,
+                                          BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        configASSERT( pxStreamBuffer );
+
+        if( prvCommitWrite( pxStreamBuffer, xBytesWritten ) != pdFALSE )
+        {
+            sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+    size_t xStreamBufferAcquireRead( StreamBufferHandle_t xStreamBuffer,
+                                     StreamBufferSpans_t * const pxSpans,
+                                     TickType_t xTicksToWait )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReturn, xBytesAvailable, xBytesToStoreMessageLength;
+
+        configASSERT( pxStreamBuffer );
+        configASSERT( pxSpans );
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        }
+        else
+        {
+            xBytesToStoreMessageLength = 0;
+        }
+
+        xBytesAvailable = prvWaitForData( pxStreamBuffer, xBytesToStoreMessageLength, xTicksToWait );
+
+        if( xBytesAvailable <= xBytesToStoreMessageLength )
+        {
+            xReturn = 0;
+        }
+        else if( xBytesToStoreMessageLength != ( size_t ) 0 )
+        {
+            /* Only the next message is handed out, without its length. */
+            xReturn = xStreamBufferNextMessageLengthBytes( xStreamBuffer );
+        }
+        else
+        {
+            xReturn = xBytesAvailable;
+        }
+
+        prvGetSpans( pxStreamBuffer, pxStreamBuffer->xTail + xBytesToStoreMessageLength, xReturn, pxSpans );
+
+        return xReturn;
+    }
+    /*-----------------------------------------------------------*/
+
+    void vStreamBufferConsumeRead( StreamBufferHandle_t xStreamBuffer,
+                                   size_t xBytesConsumed )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        configASSERT( pxStreamBuffer );
+
+        if( prvConsumeRead( pxStreamBuffer, xBytesConsumed ) != pdFALSE )
+        {
+            sbRECEIVE_COMPLETED( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+    void vStreamBufferConsumeReadFromISR( StreamBufferHandle_t xStreamBuffer,
+                                          size_t xBytesConsumed,
+                                          BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        configASSERT( pxStreamBuffer );
+
+        if( prvConsumeRead( pxStreamBuffer, xBytesConsumed ) != pdFALSE )
+        {
+            sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+    static void prvGetSpans( const StreamBuffer_t * const pxStreamBuffer,
+                             size_t xStart,
+                             size_t xCount,
+                             StreamBufferSpans_t * const pxSpans )
+    {
+        size_t xFirstLength;
+
+        if( xStart >= pxStreamBuffer->xLength )
+        {
+            xStart -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The second span is only used if the bytes wrap back to the start of
+         * the buffer. */
+        xFirstLength = configMIN( pxStreamBuffer->xLength - xStart, xCount );
+
+        pxSpans->pucData[ 0 ] = &( pxStreamBuffer->pucBuffer[ xStart ] );
+        pxSpans->xLength[ 0 ] = xFirstLength;
+        pxSpans->pucData[ 1 ] = pxStreamBuffer->pucBuffer;
+        pxSpans->xLength[ 1 ] = xCount - xFirstLength;
+    }
+    /*-----------------------------------------------------------*/
+
+    static BaseType_t prvCommitWrite( StreamBuffer_t * const pxStreamBuffer,
+                                      size_t xBytesWritten )
+    {
+        size_t xNextHead;
+        StreamBufferSpans_t xLengthSpans;
+
+        if( xBytesWritten == ( size_t ) 0 )
+        {
+            return pdFALSE;
+        }
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            configASSERT( ( xBytesWritten + sbBYTES_TO_STORE_MESSAGE_LENGTH ) <= xStreamBufferSpacesAvailable( pxStreamBuffer ) );
+
+            /* Fill in the length left in front of the message.  xHead is
+             * only moved once, past both, so the reader never sees a length
+             * without its message. */
+            prvGetSpans( pxStreamBuffer, pxStreamBuffer->xHead, sbBYTES_TO_STORE_MESSAGE_LENGTH, &xLengthSpans );
+            ( void ) memcpy( ( void * ) xLengthSpans.pucData[ 0 ], ( const void * ) &( xBytesWritten ), xLengthSpans.xLength[ 0 ] ); /*lint !e9087 memcpy() requires void *. */
+            ( void ) memcpy( ( void * ) xLengthSpans.pucData[ 1 ], ( const void * ) ( ( ( const uint8_t * ) &( xBytesWritten ) ) + xLengthSpans.xLength[ 0 ] ), xLengthSpans.xLength[ 1 ] ); /*lint !e9087 memcpy() requires void *. */
+
+            xNextHead = pxStreamBuffer->xHead + sbBYTES_TO_STORE_MESSAGE_LENGTH + xBytesWritten;
+        }
+        else
+        {
+            configASSERT( xBytesWritten <= xStreamBufferSpacesAvailable( pxStreamBuffer ) );
+
+            xNextHead = pxStreamBuffer->xHead + xBytesWritten;
+        }
+
+        if( xNextHead >= pxStreamBuffer->xLength )
+        {
+            xNextHead -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxStreamBuffer->xHead = xNextHead;
+
+        traceSTREAM_BUFFER_SEND( pxStreamBuffer, xBytesWritten );
+
+        /* Was a task waiting for the data? */
+        return ( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes ) ? pdTRUE : pdFALSE;
+    }
+    /*-----------------------------------------------------------*/
+
+    static BaseType_t prvConsumeRead( StreamBuffer_t * const pxStreamBuffer,
+                                      size_t xBytesConsumed )
+    {
+        size_t xNextTail;
+
+        if( xBytesConsumed == ( size_t ) 0 )
+        {
+            return pdFALSE;
+        }
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            /* Messages are removed whole, length included. */
+            configASSERT( xBytesConsumed == xStreamBufferNextMessageLengthBytes( pxStreamBuffer ) );
+            xBytesConsumed += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        configASSERT( xBytesConsumed <= prvBytesInBuffer( pxStreamBuffer ) );
+
+        xNextTail = pxStreamBuffer->xTail + xBytesConsumed;
+
+        if( xNextTail >= pxStreamBuffer->xLength )
+        {
+            xNextTail -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxStreamBuffer->xTail = xNextTail;
+
+        traceSTREAM_BUFFER_RECEIVE( pxStreamBuffer, xBytesConsumed );
+
+        /* Was a task waiting for space in the buffer? */
+        return pdTRUE;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
 BaseType_t xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer )
 {
     const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
@@ -1130,13 +1665,14 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
 
 static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
                                      const uint8_t * pucData,
-                                     size_t xCount )
+                                     size_t xCount,
+                                     size_t xHead )
 {
     size_t xNextHead, xFirstLength;
 
     configASSERT( xCount > ( size_t ) 0 );
 
-    xNextHead = pxStreamBuffer->xHead;
+    xNextHead = xHead;
 
     /* Calculate the number of bytes that can be added in the first write -
      * which may be less than the total number of bytes that need to be added if
@@ -1171,9 +1707,7 @@ static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
         mtCOVERAGE_TEST_MARKER();
     }
 
-    pxStreamBuffer->xHead = xNextHead;
-
-    return xCount;
+    return xNextHead;
 }
 /*-----------------------------------------------------------*/
 
@@ -1235,6 +1769,124 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t * pxStreamBuffer,
 }
 /*-----------------------------------------------------------*/
 
+static size_t prvWaitForSpace( StreamBuffer_t * const pxStreamBuffer,
+                               size_t xRequiredSpace,
+                               TickType_t xTicksToWait )
+{
+    size_t xSpace = 0;
+    TimeOut_t xTimeOut;
+
+    if( xTicksToWait != ( TickType_t ) 0 )
+    {
+        vTaskSetTimeOutState( &xTimeOut );
+
+        do
+        {
+            /* Wait until the required number of bytes are free in the message
+             * buffer. */
+            taskENTER_CRITICAL();
+            {
+                xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+                if( xSpace < xRequiredSpace )
+                {
+                    /* Clear notification state as going to wait for space. */
+                    ( void ) xTaskNotifyStateClear( NULL );
+
+                    /* Should only be one writer. */
+                    configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+                    pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+                }
+                else
+                {
+                    taskEXIT_CRITICAL();
+                    break;
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            traceBLOCKING_ON_STREAM_BUFFER_SEND( pxStreamBuffer );
+            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            pxStreamBuffer->xTaskWaitingToSend = NULL;
+        } while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( xSpace == ( size_t ) 0 )
+    {
+        xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xSpace;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWaitForData( StreamBuffer_t * const pxStreamBuffer,
+                              size_t xBytesToStoreMessageLength,
+                              TickType_t xTicksToWait )
+{
+    size_t xBytesAvailable;
+
+    if( xTicksToWait != ( TickType_t ) 0 )
+    {
+        /* Checking if there is data and clearing the notification state must be
+         * performed atomically. */
+        taskENTER_CRITICAL();
+        {
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+            /* If this function was invoked by a message buffer read then
+             * xBytesToStoreMessageLength holds the number of bytes used to hold
+             * the length of the next discrete message.  If this function was
+             * invoked by a stream buffer read then xBytesToStoreMessageLength will
+             * be 0. */
+            if( xBytesAvailable <= xBytesToStoreMessageLength )
+            {
+                /* Clear notification state as going to wait for data. */
+                ( void ) xTaskNotifyStateClear( NULL );
+
+                /* Should only be one reader. */
+                configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+                pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( xBytesAvailable <= xBytesToStoreMessageLength )
+        {
+            /* Wait for data to be available. */
+            traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( pxStreamBuffer );
+            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+            /* Recheck the data available after blocking. */
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+    }
+
+    return xBytesAvailable;
+}
+/*-----------------------------------------------------------*/
+
 static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer )
 {
 /* Returns the distance between xTail and xHead. */
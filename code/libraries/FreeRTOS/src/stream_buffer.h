@@ -69,6 +69,16 @@
 struct StreamBufferDef_t;
 typedef struct StreamBufferDef_t * StreamBufferHandle_t;
 
+/*
+ * Values for the xIsMessageBuffer parameter of xStreamBufferGenericCreate()
+ * and xStreamBufferGenericCreateStatic().  sbTYPE_MULTI_PRODUCER may be or'ed
+ * with either buffer type; pdFALSE and pdTRUE remain valid for the plain
+ * stream and message buffer types.
+ */
+#define sbTYPE_STREAM_BUFFER     ( ( BaseType_t ) 0 )
+#define sbTYPE_MESSAGE_BUFFER    ( ( BaseType_t ) 1 )
+#define sbTYPE_MULTI_PRODUCER    ( ( BaseType_t ) 2 )
+
 
 /**
  * message_buffer.h
@@ -137,6 +147,47 @@ typedef struct StreamBufferDef_t * StreamBufferHandle_t;
  */
 #define xStreamBufferCreate( xBufferSizeBytes, xTriggerLevelBytes )    xStreamBufferGenericCreate( xBufferSizeBytes, xTriggerLevelBytes, pdFALSE )
 
+/**
+ * stream_buffer.h
+ *
+ * <pre>
+ * StreamBufferHandle_t xStreamBufferCreateMultiProducer( size_t xBufferSizeBytes, size_t xTriggerLevelBytes );
+ * StreamBufferHandle_t xStreamBufferCreateMultiProducerStatic( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, uint8_t *pucStreamBufferStorageArea, StaticStreamBuffer_t *pxStaticStreamBuffer );
+ * </pre>
+ *
+ * Creates a stream buffer that any number of tasks and interrupts can write
+ * to at the same time without an external mutex.  There must still be only
+ * one reader.
+ *
+ * Each send reserves its space in a short critical section, copies its data
+ * with interrupts enabled, and then commits the space in a second short
+ * critical section.  Data becomes visible to the reader in the order the
+ * space was reserved, so each send's bytes stay together even when an
+ * interrupt writes in the middle of a task's copy; the interrupt's bytes are
+ * simply held back until the task commits.  A task sends with the scheduler
+ * suspended, so no other task can run in the middle of its copy, and a
+ * send is held back by at most one task-side copy and the interrupts that
+ * run during it.
+ *
+ * Sends to a multi-producer buffer never block: xTicksToWait is ignored and
+ * as many bytes as fit are written.  At most
+ * configSTREAM_BUFFER_MAX_RESERVATIONS sends can be in progress at once; a
+ * send that finds them all in use writes nothing.  The zero-copy acquire
+ * functions cannot be used on these buffers.
+ *
+ * configUSE_STREAM_BUFFER_MULTI_PRODUCER must be set to 1 in FreeRTOSConfig.h
+ * for these macros to be available.
+ *
+ * \defgroup xStreamBufferCreateMultiProducer xStreamBufferCreateMultiProducer
+ * \ingroup StreamBufferManagement
+ */
+#if ( configUSE_STREAM_BUFFER_MULTI_PRODUCER == 1 )
+    #define xStreamBufferCreateMultiProducer( xBufferSizeBytes, xTriggerLevelBytes ) \
+    xStreamBufferGenericCreate( xBufferSizeBytes, xTriggerLevelBytes, sbTYPE_MULTI_PRODUCER )
+    #define xStreamBufferCreateMultiProducerStatic( xBufferSizeBytes, xTriggerLevelBytes, pucStreamBufferStorageArea, pxStaticStreamBuffer ) \
+    xStreamBufferGenericCreateStatic( xBufferSizeBytes, xTriggerLevelBytes, sbTYPE_MULTI_PRODUCER, pucStreamBufferStorageArea, pxStaticStreamBuffer )
+#endif
+
 /**
  * stream_buffer.h
  *
@@ -838,6 +889,145 @@ BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer
 BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer,
                                                  BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+/**
+ * Up to two runs of bytes inside a stream buffer's storage area, as returned
+ * by xStreamBufferAcquireWrite() and xStreamBufferAcquireRead().  The second
+ * run is only used, starting at the beginning of the storage area, when the
+ * bytes wrap past its end; otherwise xLength[ 1 ] is 0.
+ */
+    typedef struct StreamBufferSpans
+    {
+        uint8_t * pucData[ 2 ];
+        size_t xLength[ 2 ];
+    } StreamBufferSpans_t;
+
+/**
+ * stream_buffer.h
+ *
+ * <pre>
+ * size_t xStreamBufferAcquireWrite( StreamBufferHandle_t xStreamBuffer, size_t xMaxBytes, StreamBufferSpans_t *pxSpans, TickType_t xTicksToWait );
+ * </pre>
+ *
+ * Hands out free space in the buffer so data can be written in place, for
+ * example by a DMA transfer, instead of being copied in by
+ * xStreamBufferSend().  Nothing is visible to the reader until
+ * vStreamBufferCommitWrite() is called.  The writer must not call any other
+ * send function in between.
+ *
+ * For a stream buffer, up to xMaxBytes of whatever space is free is handed
+ * out.  For a message buffer, space for a whole message of xMaxBytes is
+ * handed out or none at all; the message length is written by the commit.
+ *
+ * Can be called from an interrupt if xTicksToWait is 0.
+ *
+ * @param xStreamBuffer The handle of the buffer.
+ *
+ * @param xMaxBytes The number of bytes wanted.
+ *
+ * @param pxSpans Set to the one or two runs of storage to write to.
+ *
+ * @param xTicksToWait The maximum time to block for the space as
+ * xStreamBufferSend() would.
+ *
+ * @return The total length of the spans, or 0 if no space was handed out.
+ *
+ * Example usage:
+ * <pre>
+ * StreamBufferSpans_t xSpans;
+ *
+ * if( xStreamBufferAcquireWrite( xStreamBuffer, 32, &xSpans, 0 ) > 0 )
+ * {
+ *     size_t xBytes = prvUartDrain( xSpans.pucData[ 0 ], xSpans.xLength[ 0 ] );
+ *     vStreamBufferCommitWrite( xStreamBuffer, xBytes );
+ * }
+ * </pre>
+ * \defgroup xStreamBufferAcquireWrite xStreamBufferAcquireWrite
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferAcquireWrite( StreamBufferHandle_t xStreamBuffer,
+                                      size_t xMaxBytes,
+                                      StreamBufferSpans_t * const pxSpans,
+                                      TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * <pre>
+ * void vStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer, size_t xBytesWritten );
+ * void vStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer, size_t xBytesWritten, BaseType_t *pxHigherPriorityTaskWoken );
+ * </pre>
+ *
+ * Makes the first xBytesWritten bytes of the spans from the last
+ * xStreamBufferAcquireWrite() visible to the reader, and unblocks the reader
+ * if the trigger level is reached.  xBytesWritten may be less than was
+ * acquired; for a message buffer it becomes the message length.  Committing
+ * 0 bytes abandons the spans.
+ *
+ * \defgroup vStreamBufferCommitWrite vStreamBufferCommitWrite
+ * \ingroup StreamBufferManagement
+ */
+    void vStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer,
+                                   size_t xBytesWritten ) PRIVILEGED_FUNCTION;
+    void vStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+                                          size_t xBytesWritten,
+                                          BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * <pre>
+ * size_t xStreamBufferAcquireRead( StreamBufferHandle_t xStreamBuffer, StreamBufferSpans_t *pxSpans, TickType_t xTicksToWait );
+ * </pre>
+ *
+ * Hands out the data in the buffer so it can be parsed in place instead of
+ * being copied out by xStreamBufferReceive().  The data stays in the buffer
+ * until vStreamBufferConsumeRead() is called.
+ *
+ * For a stream buffer, all the bytes in the buffer are handed out.  For a
+ * message buffer, the next message is handed out without its length.
+ *
+ * Can be called from an interrupt if xTicksToWait is 0.
+ *
+ * @param pxSpans Set to the one or two runs of storage holding the data.
+ *
+ * @param xTicksToWait The maximum time to block for data as
+ * xStreamBufferReceive() would.
+ *
+ * @return The total length of the spans, or 0 if there was no data.
+ *
+ * \defgroup xStreamBufferAcquireRead xStreamBufferAcquireRead
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferAcquireRead( StreamBufferHandle_t xStreamBuffer,
+                                     StreamBufferSpans_t * const pxSpans,
+                                     TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * <pre>
+ * void vStreamBufferConsumeRead( StreamBufferHandle_t xStreamBuffer, size_t xBytesConsumed );
+ * void vStreamBufferConsumeReadFromISR( StreamBufferHandle_t xStreamBuffer, size_t xBytesConsumed, BaseType_t *pxHigherPriorityTaskWoken );
+ * </pre>
+ *
+ * Removes the first xBytesConsumed bytes handed out by the last
+ * xStreamBufferAcquireRead(), freeing the space for the writer and unblocking
+ * it if it was waiting.  A message buffer can only remove the whole message,
+ * so xBytesConsumed must be its length (or 0 to leave it in the buffer).
+ *
+ * \defgroup vStreamBufferConsumeRead vStreamBufferConsumeRead
+ * \ingroup StreamBufferManagement
+ */
+    void vStreamBufferConsumeRead( StreamBufferHandle_t xStreamBuffer,
+                                   size_t xBytesConsumed ) PRIVILEGED_FUNCTION;
+    void vStreamBufferConsumeReadFromISR( StreamBufferHandle_t xStreamBuffer,
+                                          size_t xBytesConsumed,
+                                          BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+
 /* Functions below here are not part of the public API. */
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
                                                  size_t xTriggerLevelBytes,
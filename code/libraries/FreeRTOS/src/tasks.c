@@ -38,6 +38,10 @@
 #include "task.h"
 #include "timers.h"
 #include "stack_macros.h"
+
+#if ( configUSE_DIRECT_TIMERS == 1 )
+    #include "direct_timer.h"
+#endif
 #include "semphr.h"
 
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
@@ -358,6 +362,18 @@ PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tas
 
 #endif
 
+#if ( configUSE_KERNEL_BLOCK_POOLS == 1 )
+
+/* Fixed-size pools the dynamic task allocator draws from before falling back
+ * to pvPortMalloc().  Stacks of up to configSTACK_POOL_BLOCK_DEPTH words are
+ * served from the stack pool. */
+    PRIVILEGED_DATA static TCB_t xTCBPoolStorage[ configTCB_POOL_LENGTH ];
+    PRIVILEGED_DATA static StackType_t xStackPoolStorage[ configSTACK_POOL_LENGTH ][ configSTACK_POOL_BLOCK_DEPTH ];
+    PRIVILEGED_DATA static BlockPool_t xTCBPool = portBLOCK_POOL_INITIALISER( xTCBPoolStorage, sizeof( TCB_t ), configTCB_POOL_LENGTH );
+    PRIVILEGED_DATA static BlockPool_t xStackPool = portBLOCK_POOL_INITIALISER( xStackPoolStorage, sizeof( xStackPoolStorage[ 0 ] ), configSTACK_POOL_LENGTH );
+
+#endif
+
 /* Global POSIX errno. Its value is changed upon context switching to match
  * the errno of the currently running task. */
 #if ( configUSE_POSIX_ERRNO == 1 )
@@ -449,6 +465,26 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters ) PRIVILEGED_FUNCTION;
 
 #endif
 
+/*
+ * Allocate and free the TCB and stack of a dynamically created task, taking
+ * them from the kernel block pools when configUSE_KERNEL_BLOCK_POOLS is 1.
+ */
+#if ( configUSE_KERNEL_BLOCK_POOLS == 1 )
+
+    static void * prvAllocateTCB( void ) PRIVILEGED_FUNCTION;
+    static void * prvAllocateStack( configSTACK_DEPTH_TYPE usStackDepth ) PRIVILEGED_FUNCTION;
+    static void prvFreeTCB( void * pv ) PRIVILEGED_FUNCTION;
+    static void prvFreeStack( void * pv ) PRIVILEGED_FUNCTION;
+
+#else
+
+    #define prvAllocateTCB()                   pvPortMalloc( sizeof( TCB_t ) )
+    #define prvAllocateStack( usStackDepth )    pvPortMalloc( ( ( ( size_t ) ( usStackDepth ) ) * sizeof( StackType_t ) ) )
+    #define prvFreeTCB( pv )                   vPortFree( pv )
+    #define prvFreeStack( pv )                 vPortFree( pv )
+
+#endif /* configUSE_KERNEL_BLOCK_POOLS */
+
 /*
  * Used only by the idle task.  This checks to see if anything has been placed
  * in the list of tasks waiting to be deleted.  If so the task is cleaned up
@@ -738,19 +774,19 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 /* Allocate space for the TCB.  Where the memory comes from depends on
                  * the implementation of the port malloc function and whether or not static
                  * allocation is being used. */
-                pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+                pxNewTCB = ( TCB_t * ) prvAllocateTCB();
 
                 if( pxNewTCB != NULL )
                 {
                     /* Allocate space for the stack used by the task being created.
                      * The base of the stack memory stored in the TCB so the task can
                      * be deleted later if required. */
-                    pxNewTCB->pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    pxNewTCB->pxStack = ( StackType_t * ) prvAllocateStack( usStackDepth ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
                     if( pxNewTCB->pxStack == NULL )
                     {
                         /* Could not allocate the stack.  Delete the allocated TCB. */
-                        vPortFree( pxNewTCB );
+                        prvFreeTCB( pxNewTCB );
                         pxNewTCB = NULL;
                     }
                 }
@@ -760,12 +796,12 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                 StackType_t * pxStack;
 
                 /* Allocate space for the stack used by the task being created. */
-                pxStack = ( StackType_t * ) pvPortMalloc( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the stack. */
+                pxStack = ( StackType_t * ) prvAllocateStack( usStackDepth ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the stack. */
 
                 if( pxStack != NULL )
                 {
                     /* Allocate space for the TCB. */
-                    pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
+                    pxNewTCB = ( TCB_t * ) prvAllocateTCB(); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
 
                     if( pxNewTCB != NULL )
                     {
@@ -776,7 +812,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
                     {
                         /* The stack cannot be used as the TCB was not created.  Free
                          * it again. */
-                        vPortFree( pxStack );
+                        prvFreeStack( pxStack );
                     }
                 }
                 else
@@ -2864,6 +2900,28 @@ BaseType_t xTaskIncrementTick( void )
             }
         #endif /* configUSE_TICK_HOOK */
 
+        #if ( configUSE_DIRECT_TIMERS == 1 )
+            {
+                /* As for the tick hook, direct timers have already seen the
+                 * ticks that are unwound when the scheduler is unlocked. */
+                if( xPendedTicks == ( TickType_t ) 0 )
+                {
+                    if( xDirectTimerProcessTick() != pdFALSE )
+                    {
+                        xSwitchRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        #endif /* configUSE_DIRECT_TIMERS */
+
         #if ( configUSE_PREEMPTION == 1 )
             {
                 if( xYieldPending != pdFALSE )
@@ -2888,6 +2946,15 @@ BaseType_t xTaskIncrementTick( void )
                 vApplicationTickHook();
             }
         #endif
+
+        /* So do direct timers.  A task they unblock is held on the pending
+         * ready list until the scheduler is unlocked, so the return value is not
+         * needed. */
+        #if ( configUSE_DIRECT_TIMERS == 1 )
+            {
+                ( void ) xDirectTimerProcessTick();
+            }
+        #endif
     }
 
     return xSwitchRequired;
@@ -3950,8 +4017,8 @@ static void prvCheckTasksWaitingTermination( void )
             {
                 /* The task can only have been allocated dynamically - free both
                  * the stack and TCB. */
-                vPortFree( pxTCB->pxStack );
-                vPortFree( pxTCB );
+                prvFreeStack( pxTCB->pxStack );
+                prvFreeTCB( pxTCB );
             }
         #elif ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
             {
@@ -3962,14 +4029,14 @@ static void prvCheckTasksWaitingTermination( void )
                 {
                     /* Both the stack and TCB were allocated dynamically, so both
                      * must be freed. */
-                    vPortFree( pxTCB->pxStack );
-                    vPortFree( pxTCB );
+                    prvFreeStack( pxTCB->pxStack );
+                    prvFreeTCB( pxTCB );
                 }
                 else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
                 {
                     /* Only the stack was statically allocated, so the TCB is the
                      * only memory that must be freed. */
-                    vPortFree( pxTCB );
+                    prvFreeTCB( pxTCB );
                 }
                 else
                 {
@@ -3985,6 +4052,59 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_KERNEL_BLOCK_POOLS == 1 )
+
+    static void * prvAllocateTCB( void )
+    {
+        void * pvTCB = pvPortBlockPoolAlloc( &xTCBPool );
+
+        if( pvTCB == NULL )
+        {
+            pvTCB = pvPortMalloc( sizeof( TCB_t ) );
+        }
+
+        return pvTCB;
+    }
+/*-----------------------------------------------------------*/
+
+    static void * prvAllocateStack( configSTACK_DEPTH_TYPE usStackDepth )
+    {
+        void * pvStack = NULL;
+
+        if( usStackDepth <= ( configSTACK_DEPTH_TYPE ) configSTACK_POOL_BLOCK_DEPTH )
+        {
+            pvStack = pvPortBlockPoolAlloc( &xStackPool );
+        }
+
+        if( pvStack == NULL )
+        {
+            pvStack = pvPortMalloc( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) );
+        }
+
+        return pvStack;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvFreeTCB( void * pv )
+    {
+        if( xPortBlockPoolFree( &xTCBPool, pv ) == pdFALSE )
+        {
+            vPortFree( pv );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvFreeStack( void * pv )
+    {
+        if( xPortBlockPoolFree( &xStackPool, pv ) == pdFALSE )
+        {
+            vPortFree( pv );
+        }
+    }
+
+#endif /* configUSE_KERNEL_BLOCK_POOLS */
+/*-----------------------------------------------------------*/
+
 static void prvResetNextTaskUnblockTime( void )
 {
     if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
@@ -68,6 +68,17 @@
     #define tmrSTATUS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 0x02 )
     #define tmrSTATUS_IS_AUTORELOAD              ( ( uint8_t ) 0x04 )
 
+/* Geometry of the timing wheel used when configUSE_TIMER_WHEEL is 1.  Each
+ * level resolves tmrWHEEL_SLOT_BITS bits of the expiry time, and there are
+ * enough levels to cover every bit of TickType_t, so any expiry time up to
+ * portMAX_DELAY ticks away has a slot. */
+    #if ( configUSE_TIMER_WHEEL == 1 )
+        #define tmrWHEEL_SLOT_BITS    ( 4U )
+        #define tmrWHEEL_SLOTS        ( 1U << tmrWHEEL_SLOT_BITS )
+        #define tmrWHEEL_SLOT_MASK    ( ( TickType_t ) ( tmrWHEEL_SLOTS - 1U ) )
+        #define tmrWHEEL_LEVELS       ( ( sizeof( TickType_t ) * 8U ) / tmrWHEEL_SLOT_BITS )
+    #endif
+
 /* The definition of the timers themselves. */
     typedef struct TimerDef_t
     {
@@ -127,10 +138,25 @@
  * xActiveTimerList1 and xActiveTimerList2 could be at function scope but that
  * breaks some kernel aware debuggers, and debuggers that reply on removing the
  * static qualifier. */
-    PRIVILEGED_DATA static List_t xActiveTimerList1;
-    PRIVILEGED_DATA static List_t xActiveTimerList2;
-    PRIVILEGED_DATA static List_t * pxCurrentTimerList;
-    PRIVILEGED_DATA static List_t * pxOverflowTimerList;
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/* When the timing wheel is used the active timers are instead held in the
+ * slots of a hierarchical wheel.  A timer is placed on the level of the highest
+ * digit in which its expiry time differs from xTimerWheelTime, in the slot given
+ * by that digit of its expiry time.  When xTimerWheelTime reaches a slot the
+ * timers in it are cascaded down a level, until they reach level 0 and expire.
+ * Slots are unsorted, so inserting and removing a timer are both O(1).
+ * usTimerWheelCount holds the number of timers on each level so empty levels
+ * can be skipped over. */
+        PRIVILEGED_DATA static List_t xTimerWheel[ tmrWHEEL_LEVELS ][ tmrWHEEL_SLOTS ];
+        PRIVILEGED_DATA static uint16_t usTimerWheelCount[ tmrWHEEL_LEVELS ];
+        PRIVILEGED_DATA static TickType_t xTimerWheelTime = ( TickType_t ) 0U;
+    #else
+        PRIVILEGED_DATA static List_t xActiveTimerList1;
+        PRIVILEGED_DATA static List_t xActiveTimerList2;
+        PRIVILEGED_DATA static List_t * pxCurrentTimerList;
+        PRIVILEGED_DATA static List_t * pxOverflowTimerList;
+    #endif /* configUSE_TIMER_WHEEL */
 
 /* A queue that is used to send commands to the timer service task. */
     PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
@@ -168,18 +194,39 @@
                                                   const TickType_t xTimeNow,
                                                   const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
 
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/*
+ * Place the timer in the wheel slot for its expiry time, relative to the
+ * current position of the wheel.
+ */
+        static void prvInsertTimerInWheel( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove the timer from whichever wheel slot it is in.
+ */
+        static void prvRemoveTimerFromWheel( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Turn the wheel forward to xTimeNow, cascading timers down the levels as
+ * their slots are reached and processing every timer that expires on the way.
+ */
+        static void prvAdvanceTimerWheel( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+    #else
+
 /*
  * An active timer has reached its expire time.  Reload the timer if it is an
  * auto-reload timer, then call its callback.
  */
-    static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
-                                        const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+        static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
+                                            const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
 
 /*
  * The tick count has overflowed.  Switch the timer lists after ensuring the
  * current timer list does not still reference some timers.
  */
-    static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+        static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+    #endif /* configUSE_TIMER_WHEEL */
 
 /*
  * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
@@ -501,47 +548,51 @@
     }
 /*-----------------------------------------------------------*/
 
-    static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
-                                        const TickType_t xTimeNow )
-    {
-        BaseType_t xResult;
-        Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+    #if ( configUSE_TIMER_WHEEL == 0 )
 
-        /* Remove the timer from the list of active timers.  A check has already
-         * been performed to ensure the list is not empty. */
+        static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
+                                            const TickType_t xTimeNow )
+        {
+            BaseType_t xResult;
+            Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 
-        ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
-        traceTIMER_EXPIRED( pxTimer );
+            /* Remove the timer from the list of active timers.  A check has already
+             * been performed to ensure the list is not empty. */
 
-        /* If the timer is an auto-reload timer then calculate the next
-         * expiry time and re-insert the timer in the list of active timers. */
-        if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
-        {
-            /* The timer is inserted into a list using a time relative to anything
-             * other than the current time.  It will therefore be inserted into the
-             * correct list relative to the time this task thinks it is now. */
-            if( prvInsertTimerInActiveList( pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNextExpireTime ) != pdFALSE )
+            ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+            traceTIMER_EXPIRED( pxTimer );
+
+            /* If the timer is an auto-reload timer then calculate the next
+             * expiry time and re-insert the timer in the list of active timers. */
+            if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
             {
-                /* The timer expired before it was added to the active timer
-                 * list.  Reload it now.  */
-                xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
-                configASSERT( xResult );
-                ( void ) xResult;
+                /* The timer is inserted into a list using a time relative to anything
+                 * other than the current time.  It will therefore be inserted into the
+                 * correct list relative to the time this task thinks it is now. */
+                if( prvInsertTimerInActiveList( pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNextExpireTime ) != pdFALSE )
+                {
+                    /* The timer expired before it was added to the active timer
+                     * list.  Reload it now.  */
+                    xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
+                    configASSERT( xResult );
+                    ( void ) xResult;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
             else
             {
+                pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
                 mtCOVERAGE_TEST_MARKER();
             }
-        }
-        else
-        {
-            pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
-            mtCOVERAGE_TEST_MARKER();
+
+            /* Call the timer callback. */
+            pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
         }
 
-        /* Call the timer callback. */
-        pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
-    }
+    #endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
     static portTASK_FUNCTION( prvTimerTask, pvParameters )
@@ -580,52 +631,35 @@
     }
 /*-----------------------------------------------------------*/
 
-    static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
-                                            BaseType_t xListWasEmpty )
-    {
-        TickType_t xTimeNow;
-        BaseType_t xTimerListsWereSwitched;
+    #if ( configUSE_TIMER_WHEEL == 1 )
 
-        vTaskSuspendAll();
+        static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
+                                                BaseType_t xListWasEmpty )
         {
-            /* Obtain the time now to make an assessment as to whether the timer
-             * has expired or not.  If obtaining the time causes the lists to switch
-             * then don't process this timer as any timers that remained in the list
-             * when the lists were switched will have been processed within the
-             * prvSampleTimeNow() function. */
-            xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
-
-            if( xTimerListsWereSwitched == pdFALSE )
+            TickType_t xTimeNow;
+
+            vTaskSuspendAll();
             {
-                /* The tick count has not overflowed, has the timer expired? */
-                if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+                /* The wheel does not have to be switched when the tick count
+                 * overflows as its slots are addressed relative to the wheel time.
+                 * Measuring both the next event and the time now from the wheel
+                 * time keeps the comparison correct across the overflow. */
+                xTimeNow = xTaskGetTickCount();
+
+                if( ( xListWasEmpty == pdFALSE ) && ( ( ( TickType_t ) ( xNextExpireTime - xTimerWheelTime ) ) <= ( ( TickType_t ) ( xTimeNow - xTimerWheelTime ) ) ) )
                 {
                     ( void ) xTaskResumeAll();
-                    prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+                    prvAdvanceTimerWheel( xTimeNow );
                 }
                 else
                 {
-                    /* The tick count has not overflowed, and the next expire
-                     * time has not been reached yet.  This task should therefore
-                     * block to wait for the next expire time or a command to be
-                     * received - whichever comes first.  The following line cannot
-                     * be reached unless xNextExpireTime > xTimeNow, except in the
-                     * case when the current timer list is empty. */
-                    if( xListWasEmpty != pdFALSE )
-                    {
-                        /* The current timer list is empty - is the overflow list
-                         * also empty? */
-                        xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
-                    }
-
+                    /* Block until either the next event is reached or a command
+                     * is received - whichever comes first.  If the wheel is empty
+                     * the block time is indefinite. */
                     vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
 
                     if( xTaskResumeAll() == pdFALSE )
                     {
-                        /* Yield to wait for either a command to arrive, or the
-                         * block time to expire.  If a command arrived between the
-                         * critical section being exited and this yield then the yield
-                         * will not cause the task to block. */
                         portYIELD_WITHIN_API();
                     }
                     else
@@ -634,106 +668,269 @@
                     }
                 }
             }
-            else
+        }
+
+    #else
+
+        static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
+                                                BaseType_t xListWasEmpty )
+        {
+            TickType_t xTimeNow;
+            BaseType_t xTimerListsWereSwitched;
+
+            vTaskSuspendAll();
             {
-                ( void ) xTaskResumeAll();
+                /* Obtain the time now to make an assessment as to whether the timer
+                 * has expired or not.  If obtaining the time causes the lists to switch
+                 * then don't process this timer as any timers that remained in the list
+                 * when the lists were switched will have been processed within the
+                 * prvSampleTimeNow() function. */
+                xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+
+                if( xTimerListsWereSwitched == pdFALSE )
+                {
+                    /* The tick count has not overflowed, has the timer expired? */
+                    if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+                    {
+                        ( void ) xTaskResumeAll();
+                        prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+                    }
+                    else
+                    {
+                        /* The tick count has not overflowed, and the next expire
+                         * time has not been reached yet.  This task should therefore
+                         * block to wait for the next expire time or a command to be
+                         * received - whichever comes first.  The following line cannot
+                         * be reached unless xNextExpireTime > xTimeNow, except in the
+                         * case when the current timer list is empty. */
+                        if( xListWasEmpty != pdFALSE )
+                        {
+                            /* The current timer list is empty - is the overflow list
+                             * also empty? */
+                            xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+                        }
+
+                        vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
+
+                        if( xTaskResumeAll() == pdFALSE )
+                        {
+                            /* Yield to wait for either a command to arrive, or the
+                             * block time to expire.  If a command arrived between the
+                             * critical section being exited and this yield then the yield
+                             * will not cause the task to block. */
+                            portYIELD_WITHIN_API();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+                else
+                {
+                    ( void ) xTaskResumeAll();
+                }
             }
         }
-    }
-/*-----------------------------------------------------------*/
 
-    static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
-    {
-        TickType_t xNextExpireTime;
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
 
-        /* Timers are listed in expiry time order, with the head of the list
-         * referencing the task that will expire first.  Obtain the time at which
-         * the timer with the nearest expiry time will expire.  If there are no
-         * active timers then just set the next expire time to 0.  That will cause
-         * this task to unblock when the tick count overflows, at which point the
-         * timer lists will be switched and the next expiry time can be
-         * re-assessed.  */
-        *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+    #if ( configUSE_TIMER_WHEEL == 1 )
 
-        if( *pxListWasEmpty == pdFALSE )
+        static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            TickType_t xNearest = portMAX_DELAY, xDistance;
+            UBaseType_t uxLevel, uxShift, uxSlot, uxStep;
+
+            *pxListWasEmpty = pdTRUE;
+
+            /* The next event is either a timer on level 0 expiring, or the wheel
+             * reaching an occupied slot on a higher level so its timers can be
+             * cascaded down.  On every level the occupied slots come after the
+             * current position of the wheel, so search forward from there.  Only
+             * the top level can hold timers that wait for the wheel to wrap back
+             * round to the current slot. */
+            for( uxLevel = 0U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+            {
+                if( usTimerWheelCount[ uxLevel ] != 0U )
+                {
+                    *pxListWasEmpty = pdFALSE;
+                    uxShift = uxLevel * tmrWHEEL_SLOT_BITS;
+
+                    for( uxStep = 1U; uxStep < tmrWHEEL_SLOTS; uxStep++ )
+                    {
+                        uxSlot = ( UBaseType_t ) ( ( ( xTimerWheelTime >> uxShift ) + uxStep ) & tmrWHEEL_SLOT_MASK );
+
+                        if( listLIST_IS_EMPTY( &( xTimerWheel[ uxLevel ][ uxSlot ] ) ) == pdFALSE )
+                        {
+                            break;
+                        }
+                    }
+
+                    /* The slot is reached uxStep slot widths on from the start of
+                     * the current slot.  If no later slot was occupied uxStep is
+                     * tmrWHEEL_SLOTS, which is a full turn of the top level. */
+                    xDistance = ( TickType_t ) ( ( ( uint32_t ) uxStep << uxShift ) - ( xTimerWheelTime & ( ( ( TickType_t ) 1U << uxShift ) - 1U ) ) );
+
+                    if( xDistance < xNearest )
+                    {
+                        xNearest = xDistance;
+                    }
+                }
+            }
+
+            return xTimerWheelTime + xNearest;
         }
-        else
+
+    #else
+
+        static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
         {
-            /* Ensure the task unblocks when the tick count rolls over. */
-            xNextExpireTime = ( TickType_t ) 0U;
+            TickType_t xNextExpireTime;
+
+            /* Timers are listed in expiry time order, with the head of the list
+             * referencing the task that will expire first.  Obtain the time at which
+             * the timer with the nearest expiry time will expire.  If there are no
+             * active timers then just set the next expire time to 0.  That will cause
+             * this task to unblock when the tick count overflows, at which point the
+             * timer lists will be switched and the next expiry time can be
+             * re-assessed.  */
+            *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+
+            if( *pxListWasEmpty == pdFALSE )
+            {
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            }
+            else
+            {
+                /* Ensure the task unblocks when the tick count rolls over. */
+                xNextExpireTime = ( TickType_t ) 0U;
+            }
+
+            return xNextExpireTime;
         }
 
-        return xNextExpireTime;
-    }
+    #endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
-    static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
-    {
-        TickType_t xTimeNow;
-        PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
-
-        xTimeNow = xTaskGetTickCount();
+    #if ( configUSE_TIMER_WHEEL == 1 )
 
-        if( xTimeNow < xLastTime )
-        {
-            prvSwitchTimerLists();
-            *pxTimerListsWereSwitched = pdTRUE;
-        }
-        else
+        static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
         {
+            TickType_t xTimeNow;
+
+            /* Bring the wheel up to the time now so any timer the caller inserts
+             * is placed relative to it.  There are never any lists to switch. */
+            xTimeNow = xTaskGetTickCount();
+            prvAdvanceTimerWheel( xTimeNow );
             *pxTimerListsWereSwitched = pdFALSE;
+
+            return xTimeNow;
         }
 
-        xLastTime = xTimeNow;
+    #else
 
-        return xTimeNow;
-    }
-/*-----------------------------------------------------------*/
+        static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
+        {
+            TickType_t xTimeNow;
+            PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
 
-    static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer,
-                                                  const TickType_t xNextExpiryTime,
-                                                  const TickType_t xTimeNow,
-                                                  const TickType_t xCommandTime )
-    {
-        BaseType_t xProcessTimerNow = pdFALSE;
+            xTimeNow = xTaskGetTickCount();
+
+            if( xTimeNow < xLastTime )
+            {
+                prvSwitchTimerLists();
+                *pxTimerListsWereSwitched = pdTRUE;
+            }
+            else
+            {
+                *pxTimerListsWereSwitched = pdFALSE;
+            }
 
-        listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
-        listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+            xLastTime = xTimeNow;
 
-        if( xNextExpiryTime <= xTimeNow )
+            return xTimeNow;
+        }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer,
+                                                      const TickType_t xNextExpiryTime,
+                                                      const TickType_t xTimeNow,
+                                                      const TickType_t xCommandTime )
         {
+            BaseType_t xProcessTimerNow = pdFALSE;
+
+            listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
+            listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+
             /* Has the expiry time elapsed between the command to start/reset a
-             * timer was issued, and the time the command was processed? */
-            if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+             * timer was issued, and the time the command was processed?  Both
+             * times are measured from the command time so the tick count
+             * overflowing in between does not matter.  prvSampleTimeNow() has
+             * already moved the wheel up to xTimeNow. */
+            if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= ( ( TickType_t ) ( xNextExpiryTime - xCommandTime ) ) )
             {
-                /* The time between a command being issued and the command being
-                 * processed actually exceeds the timers period.  */
                 xProcessTimerNow = pdTRUE;
             }
             else
             {
-                vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+                prvInsertTimerInWheel( pxTimer );
             }
+
+            return xProcessTimerNow;
         }
-        else
+
+    #else
+
+        static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer,
+                                                      const TickType_t xNextExpiryTime,
+                                                      const TickType_t xTimeNow,
+                                                      const TickType_t xCommandTime )
         {
-            if( ( xTimeNow < xCommandTime ) && ( xNextExpiryTime >= xCommandTime ) )
+            BaseType_t xProcessTimerNow = pdFALSE;
+
+            listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
+            listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+
+            if( xNextExpiryTime <= xTimeNow )
             {
-                /* If, since the command was issued, the tick count has overflowed
-                 * but the expiry time has not, then the timer must have already passed
-                 * its expiry time and should be processed immediately. */
-                xProcessTimerNow = pdTRUE;
+                /* Has the expiry time elapsed between the command to start/reset a
+                 * timer was issued, and the time the command was processed? */
+                if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                {
+                    /* The time between a command being issued and the command being
+                     * processed actually exceeds the timers period.  */
+                    xProcessTimerNow = pdTRUE;
+                }
+                else
+                {
+                    vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+                }
             }
             else
             {
-                vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                if( ( xTimeNow < xCommandTime ) && ( xNextExpiryTime >= xCommandTime ) )
+                {
+                    /* If, since the command was issued, the tick count has overflowed
+                     * but the expiry time has not, then the timer must have already passed
+                     * its expiry time and should be processed immediately. */
+                    xProcessTimerNow = pdTRUE;
+                }
+                else
+                {
+                    vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                }
             }
+
+            return xProcessTimerNow;
         }
 
-        return xProcessTimerNow;
-    }
+    #endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
     static void prvProcessReceivedCommands( void )
@@ -778,7 +975,15 @@
                 if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
                 {
                     /* The timer is in a list, remove it. */
-                    ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                    #if ( configUSE_TIMER_WHEEL == 1 )
+                        {
+                            prvRemoveTimerFromWheel( pxTimer );
+                        }
+                    #else
+                        {
+                            ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                        }
+                    #endif /* configUSE_TIMER_WHEEL */
                 }
                 else
                 {
@@ -886,64 +1091,205 @@
     }
 /*-----------------------------------------------------------*/
 
-    static void prvSwitchTimerLists( void )
-    {
-        TickType_t xNextExpireTime, xReloadTime;
-        List_t * pxTemp;
-        Timer_t * pxTimer;
-        BaseType_t xResult;
+    #if ( configUSE_TIMER_WHEEL == 0 )
 
-        /* The tick count has overflowed.  The timer lists must be switched.
-         * If there are any timers still referenced from the current timer list
-         * then they must have expired and should be processed before the lists
-         * are switched. */
-        while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+        static void prvSwitchTimerLists( void )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            TickType_t xNextExpireTime, xReloadTime;
+            List_t * pxTemp;
+            Timer_t * pxTimer;
+            BaseType_t xResult;
+
+            /* The tick count has overflowed.  The timer lists must be switched.
+             * If there are any timers still referenced from the current timer list
+             * then they must have expired and should be processed before the lists
+             * are switched. */
+            while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+            {
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
 
-            /* Remove the timer from the list. */
-            pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-            ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
-            traceTIMER_EXPIRED( pxTimer );
+                /* Remove the timer from the list. */
+                pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                traceTIMER_EXPIRED( pxTimer );
 
-            /* Execute its callback, then send a command to restart the timer if
-             * it is an auto-reload timer.  It cannot be restarted here as the lists
-             * have not yet been switched. */
-            pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+                /* Execute its callback, then send a command to restart the timer if
+                 * it is an auto-reload timer.  It cannot be restarted here as the lists
+                 * have not yet been switched. */
+                pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
 
-            if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
-            {
-                /* Calculate the reload value, and if the reload value results in
-                 * the timer going into the same timer list then it has already expired
-                 * and the timer should be re-inserted into the current list so it is
-                 * processed again within this loop.  Otherwise a command should be sent
-                 * to restart the timer to ensure it is only inserted into a list after
-                 * the lists have been swapped. */
-                xReloadTime = ( xNextExpireTime + pxTimer->xTimerPeriodInTicks );
-
-                if( xReloadTime > xNextExpireTime )
+                if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
                 {
-                    listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xReloadTime );
-                    listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
-                    vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                    /* Calculate the reload value, and if the reload value results in
+                     * the timer going into the same timer list then it has already expired
+                     * and the timer should be re-inserted into the current list so it is
+                     * processed again within this loop.  Otherwise a command should be sent
+                     * to restart the timer to ensure it is only inserted into a list after
+                     * the lists have been swapped. */
+                    xReloadTime = ( xNextExpireTime + pxTimer->xTimerPeriodInTicks );
+
+                    if( xReloadTime > xNextExpireTime )
+                    {
+                        listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xReloadTime );
+                        listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+                        vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                    }
+                    else
+                    {
+                        xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
+                        configASSERT( xResult );
+                        ( void ) xResult;
+                    }
                 }
                 else
                 {
-                    xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
-                    configASSERT( xResult );
-                    ( void ) xResult;
+                    mtCOVERAGE_TEST_MARKER();
                 }
             }
+
+            pxTemp = pxCurrentTimerList;
+            pxCurrentTimerList = pxOverflowTimerList;
+            pxOverflowTimerList = pxTemp;
+        }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        static void prvInsertTimerInWheel( Timer_t * const pxTimer )
+        {
+            const TickType_t xExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+            const TickType_t xDifference = xExpiryTime ^ xTimerWheelTime;
+            UBaseType_t uxLevel = 0U, uxShift = 0U;
+
+            /* Find the highest digit in which the expiry time differs from the
+             * wheel time. */
+            while( ( xDifference >> uxShift ) > tmrWHEEL_SLOT_MASK )
+            {
+                uxLevel++;
+                uxShift += tmrWHEEL_SLOT_BITS;
+            }
+
+            /* If that digit of the expiry time is behind the wheel's then the
+             * expiry time is only ahead because the tick count will overflow
+             * first.  The timer waits on the top level for the wheel to wrap. */
+            if( ( ( xExpiryTime >> uxShift ) & tmrWHEEL_SLOT_MASK ) < ( ( xTimerWheelTime >> uxShift ) & tmrWHEEL_SLOT_MASK ) )
+            {
+                uxLevel = tmrWHEEL_LEVELS - 1U;
+                uxShift = uxLevel * tmrWHEEL_SLOT_BITS;
+            }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
+
+            vListInsertEnd( &( xTimerWheel[ uxLevel ][ ( xExpiryTime >> uxShift ) & tmrWHEEL_SLOT_MASK ] ), &( pxTimer->xTimerListItem ) );
+            usTimerWheelCount[ uxLevel ]++;
         }
+/*-----------------------------------------------------------*/
 
-        pxTemp = pxCurrentTimerList;
-        pxCurrentTimerList = pxOverflowTimerList;
-        pxOverflowTimerList = pxTemp;
-    }
+        static void prvRemoveTimerFromWheel( Timer_t * const pxTimer )
+        {
+            /* The level is recovered from the position of the slot within the
+             * wheel. */
+            const size_t xSlotIndex = ( size_t ) ( listLIST_ITEM_CONTAINER( &( pxTimer->xTimerListItem ) ) - &( xTimerWheel[ 0 ][ 0 ] ) );
+
+            ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+            usTimerWheelCount[ xSlotIndex / tmrWHEEL_SLOTS ]--;
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvAdvanceTimerWheel( const TickType_t xTimeNow )
+        {
+            TickType_t xRemaining = ( TickType_t ) ( xTimeNow - xTimerWheelTime );
+            TickType_t xSlotMask, xStep;
+            UBaseType_t uxLevel, uxShift;
+            List_t * pxSlot;
+            Timer_t * pxTimer;
+
+            while( xRemaining > ( TickType_t ) 0U )
+            {
+                /* Nothing can happen before the next slot boundary of the lowest
+                 * level that holds any timers, so jump straight there. */
+                uxLevel = 0U;
+
+                while( ( uxLevel < tmrWHEEL_LEVELS ) && ( usTimerWheelCount[ uxLevel ] == 0U ) )
+                {
+                    uxLevel++;
+                }
+
+                if( uxLevel == tmrWHEEL_LEVELS )
+                {
+                    /* The wheel is empty. */
+                    xTimerWheelTime = xTimeNow;
+                    break;
+                }
+
+                xSlotMask = ( ( TickType_t ) 1U << ( uxLevel * tmrWHEEL_SLOT_BITS ) ) - 1U;
+                xStep = ( TickType_t ) ( ( xSlotMask - ( xTimerWheelTime & xSlotMask ) ) + 1U );
+
+                if( xStep > xRemaining )
+                {
+                    xTimerWheelTime = xTimeNow;
+                    break;
+                }
+
+                xTimerWheelTime += xStep;
+                xRemaining -= xStep;
+
+                /* Cascade the slot the wheel has just entered on every level whose
+                 * boundary has been crossed.  The timers are re-inserted relative to
+                 * the new wheel time so they always move to a lower level. */
+                for( uxLevel = tmrWHEEL_LEVELS - 1U; uxLevel > 0U; uxLevel-- )
+                {
+                    uxShift = uxLevel * tmrWHEEL_SLOT_BITS;
+
+                    if( ( xTimerWheelTime & ( ( ( TickType_t ) 1U << uxShift ) - 1U ) ) == ( TickType_t ) 0U )
+                    {
+                        pxSlot = &( xTimerWheel[ uxLevel ][ ( xTimerWheelTime >> uxShift ) & tmrWHEEL_SLOT_MASK ] );
+
+                        while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+                        {
+                            pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                            prvRemoveTimerFromWheel( pxTimer );
+                            prvInsertTimerInWheel( pxTimer );
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                /* Every timer in the level 0 slot for the wheel time expires now. */
+                pxSlot = &( xTimerWheel[ 0 ][ xTimerWheelTime & tmrWHEEL_SLOT_MASK ] );
+
+                while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+                {
+                    pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    prvRemoveTimerFromWheel( pxTimer );
+                    traceTIMER_EXPIRED( pxTimer );
+
+                    /* An auto-reload timer is reloaded relative to its expiry
+                     * time, which is the wheel time, so it can never land back in
+                     * the slot being emptied. */
+                    if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+                    {
+                        listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xTimerWheelTime + pxTimer->xTimerPeriodInTicks );
+                        prvInsertTimerInWheel( pxTimer );
+                    }
+                    else
+                    {
+                        pxTimer->ucStatus &= ~tmrSTATUS_IS_ACTIVE;
+                    }
+
+                    pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+                }
+            }
+        }
+
+    #endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
     static void prvCheckForValidListAndQueue( void )
@@ -955,10 +1301,28 @@
         {
             if( xTimerQueue == NULL )
             {
-                vListInitialise( &xActiveTimerList1 );
-                vListInitialise( &xActiveTimerList2 );
-                pxCurrentTimerList = &xActiveTimerList1;
-                pxOverflowTimerList = &xActiveTimerList2;
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                    {
+                        UBaseType_t uxLevel, uxSlot;
+
+                        for( uxLevel = 0U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+                        {
+                            for( uxSlot = 0U; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+                            {
+                                vListInitialise( &( xTimerWheel[ uxLevel ][ uxSlot ] ) );
+                            }
+
+                            usTimerWheelCount[ uxLevel ] = 0U;
+                        }
+                    }
+                #else
+                    {
+                        vListInitialise( &xActiveTimerList1 );
+                        vListInitialise( &xActiveTimerList2 );
+                        pxCurrentTimerList = &xActiveTimerList1;
+                        pxOverflowTimerList = &xActiveTimerList2;
+                    }
+                #endif /* configUSE_TIMER_WHEEL */
 
                 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                     {